@@ -1,5 +1,6 @@
 #include "Boss.h"
 #include "TimedEvent.h"
+#include "TextureCache.h"
 
 #include <algorithm>
 #include <random>
@@ -18,6 +19,9 @@ Boss::Boss(glm::ivec2 spawn_pos,
 {
 	m_enabled = false;
 
+	// The boss and its blocks act together during the fight, none of them can sleep
+	m_always_active = true;
+
 	m_pos = spawn_pos;
 	m_first_pos = spawn_pos;
 	m_other_pos = other_pos;
@@ -25,8 +29,7 @@ Boss::Boss(glm::ivec2 spawn_pos,
 	m_collision_box_size = { m_tilemap->getTileSize() * 3, m_tilemap->getTileSize() * 3 };
 	S_FACE_OFFSET = -m_tilemap->getTileSize() / 2;
 
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile(boss_texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get(boss_texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_sprite.reset(Sprite::createSprite(
 		quad_size,
 		{ 0.3333333f, 1.0f },
@@ -71,8 +74,7 @@ Boss::Boss(glm::ivec2 spawn_pos,
 		initBlock(i);
 
 	std::shared_ptr<Texture> face_tex;
-	face_tex.reset(new Texture());
-	face_tex->loadFromFile(blocks_texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
+	face_tex = TextureCache::get(blocks_texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_miniface.reset(Sprite::createSprite(
 		{ m_tilemap->getTileSize(), m_tilemap->getTileSize() },
 		{ 0.125f, 0.5f },
@@ -86,17 +88,22 @@ void Boss::update(int delta_time)
 	if (!m_enabled)
 		return;
 
-	auto pre_pos = m_pos;
-
 	Entity::update(delta_time);
+}
+
+void Boss::lateUpdate(int delta_time) 
+{
+	if (!m_enabled)
+		return;
+
 	m_sprite->setPosition(m_pos + glm::ivec2(0, S_FACE_OFFSET));
 
 
 	for (auto& block : m_blocks) 
 	{
-		if (m_state != State::Move && pre_pos != m_pos) 
+		if (m_state != State::Move && m_previous_pos != m_pos) 
 		{
-			auto change = m_pos - pre_pos;
+			auto change = m_pos - m_previous_pos;
 			block->changePosition(change);
 		}
 	}
@@ -247,10 +254,10 @@ void Boss::update(int delta_time)
 	}
 }
 
-void Boss::render() 
+void Boss::render(SpriteBatch& batch) 
 {
 	if (m_vulnerable)
-		m_sprite->render();
+		m_sprite->render(batch);
 }
 
 void Boss::collideWithEntity(Collision collision) 
@@ -374,14 +381,15 @@ BossBlock::BossBlock(std::shared_ptr<TileMap> tilemap,
 {
 	std::string path = "images/Blocks2.png";
 
+	m_always_active = true;
+
 	glm::vec2 size_in_texture{ 0.125f, 0.5f };
 	glm::vec2 pos_in_texture{ 0.75f , 0.5f };
 	glm::ivec2 quad_size = { tilemap->getTileSize(), tilemap->getTileSize() };
 
 	m_tilemap = tilemap;
 
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile(path, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get(path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_sprite.reset(Sprite::createSprite(
 		quad_size,
 		size_in_texture,
@@ -396,10 +404,8 @@ BossBlock::BossBlock(std::shared_ptr<TileMap> tilemap,
 	m_enabled = false;
 }
 
-void BossBlock::update(int delta_time) 
+void BossBlock::lateUpdate(int delta_time) 
 {
-	Entity::update(delta_time);
-
 	if (m_face) 
 		m_face->setPosition(m_pos);
 
@@ -417,13 +423,13 @@ void BossBlock::update(int delta_time)
 	}
 }
 
-void BossBlock::render() 
+void BossBlock::render(SpriteBatch& batch) 
 {
-	m_sprite->render();
+	m_sprite->render(batch);
 
 	if (m_face) 
 	{
-		m_face->render();
+		m_face->render(batch);
 	}
 }
 
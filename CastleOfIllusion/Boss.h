@@ -11,9 +11,9 @@ public:
 	BossBlock(std::shared_ptr<TileMap> tilemap,
 		std::shared_ptr<ShaderProgram> shader_program);
 
-	virtual void update(int delta_time) override;
+	virtual void lateUpdate(int delta_time) override;
 
-	virtual void render() override;
+	virtual void render(SpriteBatch& batch) override;
 
 	void move(glm::ivec2 target_pos, int target_ms);
 
@@ -62,7 +62,9 @@ public:
 
 	virtual void update(int delta_time) override;
 
-	virtual void render() override;
+	virtual void lateUpdate(int delta_time) override;
+
+	virtual void render(SpriteBatch& batch) override;
 
 	virtual EntityType getType() const override { return EntityType::Boss; }
 
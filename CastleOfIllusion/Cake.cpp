@@ -1,5 +1,6 @@
 #include "Cake.h"
 #include "TimedEvent.h"
+#include "TextureCache.h"
 #include <iostream>
 
 Cake::Cake(glm::ivec2 pos,
@@ -7,19 +8,16 @@ Cake::Cake(glm::ivec2 pos,
     glm::ivec2 tilemap_pos,
     std::shared_ptr<ShaderProgram> shader_program,
     bool is_big)
-    : m_is_big(is_big)
 {
     m_tilemap = tilemap;
-    m_spritesheet.reset(new Texture());
-    m_spritesheet->loadFromFile("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
+    m_spritesheet = TextureCache::get("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
     glm::vec2 size_in_texture = glm::vec2(0.125f, 0.5f);
     m_sprite.reset(Sprite::createSprite(glm::ivec2(tilemap->getTileSize(), tilemap->getTileSize()) /* quad_size */,
         size_in_texture,
         m_spritesheet,
         shader_program));
 
-    glm::vec2 tex_coords = is_big ? glm::vec2(0.125f, 0.0f) : glm::vec2(0.0f, 0.0f);
-    m_sprite->setTextureCoordsOffset(tex_coords);
+    setBig(is_big);
 
     setPosition(pos);
     m_collision_box_size = glm::ivec2(tilemap->getTileSize(), tilemap->getTileSize());
@@ -28,6 +26,7 @@ Cake::Cake(glm::ivec2 pos,
     m_can_collide = false;
     m_affected_by_gravity = true;
     m_bounces = true;
+    m_receives_collision_stay = false;
 }
 
 void Cake::update(int delta_time)
@@ -62,24 +61,32 @@ void Cake::setEnabled(bool enabled)
 
     if (enabled) 
     {
-        auto NoCollideAtStart = [this]()
+        // Forget what the last use left, in case it comes from a pool
+        unsigned int use = ++m_uses;
+        m_can_collide = false;
+        m_sprite->stopFlickering();
+
+        auto NoCollideAtStart = [this, use]()
         {
-            if (!m_enabled)
+            if (!m_enabled || use != m_uses)
                 return;
 
             m_can_collide = true;
         };
         TimedEvents::pushEvent(std::make_unique<TimedEvent>(200, NoCollideAtStart));
 
-        auto Flicker = [this]() 
+        auto Flicker = [this, use]() 
         {
+            if (use != m_uses)
+                return;
+
             m_sprite->startFlickering();
         };
         TimedEvents::pushEvent(std::make_unique<TimedEvent>(s_timeout/2, Flicker));
 
-        auto Destroy = [this]()
+        auto Destroy = [this, use]()
         {
-            if (!m_enabled)
+            if (!m_enabled || use != m_uses)
                 return;
 
             m_enabled = false;
@@ -89,6 +96,14 @@ void Cake::setEnabled(bool enabled)
     }
 }
 
+void Cake::setBig(bool is_big)
+{
+    m_is_big = is_big;
+
+    glm::vec2 tex_coords = is_big ? glm::vec2(0.125f, 0.0f) : glm::vec2(0.0f, 0.0f);
+    m_sprite->setTextureCoordsOffset(tex_coords);
+}
+
 unsigned int Cake::getPower() const
 {
     if (m_is_big)
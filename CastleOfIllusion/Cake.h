@@ -21,9 +21,12 @@ public:
 
 	virtual EntityType getType() const override { return EntityType::Cake; }
 
-	// Sets whether the coin is enabled or not
+	// Sets whether the cake is enabled or not
     virtual void setEnabled(bool enabled) override; 
 
+	// Makes the cake big or small
+	void setBig(bool is_big);
+
 	unsigned int getPower() const;
 
 private:
@@ -41,6 +44,9 @@ private:
 
 	// True iff this cake is big, false if it is small
 	bool m_is_big;
+
+	// The number of times it has been enabled. It is pooled, so the timed events of a previous use check it
+	unsigned int m_uses = 0;
 };
 
 #endif // _CAKE_INCLUDE
@@ -1,5 +1,6 @@
 #include "CameraPoint.h"
 #include "TimedEvent.h"
+#include "Game.h"
 
 
 CameraPoint::CameraPoint(glm::ivec2 upleft_corner_pos, 
@@ -71,7 +72,7 @@ void CameraPoint::collideWithEntity(Collision collision)
 		{
 			auto SetColor = []()
 			{
-				glClearColor(64.0f / 255.0f, 33.0f / 255.0f, 16.0f / 255.0f, 1.0f);
+				Game::setClearColor(64.0f / 255.0f, 33.0f / 255.0f, 16.0f / 255.0f);
 			};
 			TimedEvents::pushEvent(std::make_unique<TimedEvent>(800, SetColor));
 		}
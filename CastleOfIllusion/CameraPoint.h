@@ -26,7 +26,7 @@ public:
 	virtual void update(int delta_time) final override {}
 
 	// Render function that does nothing (we have nothing to render)
-	virtual void render() final override {}
+	virtual void render(SpriteBatch&) final override {}
 
 	// Called when the entity collides with something
 	virtual void collideWithEntity(Collision collision);
@@ -6,7 +6,7 @@ Chest::Chest(glm::ivec2 pos,
 	std::shared_ptr<TileMap> tilemap,
 	glm::ivec2 tilemap_pos,
 	std::shared_ptr<ShaderProgram> shader_program,
-	std::shared_ptr<Entity> content)
+	std::function<void(glm::ivec2)> spawn_content)
 	:
 		ThrowableTile(pos,
 			tilemap,
@@ -17,7 +17,7 @@ Chest::Chest(glm::ivec2 pos,
 			{ 0.0f, 0.0f }, /* pos_in_texture */
 			true /* destroyed_on_impact */
 		),
-		m_content(content)
+		m_spawn_content(std::move(spawn_content))
 {
 	
 }
@@ -33,9 +33,7 @@ void Chest::onDestroy()
 
 	auto SpawnContent = [this]() 
 	{
-		m_content->setPosition(m_pos);
-		m_content->setVelocity({ 0.0f, -1.5f });
-		m_content->setEnabled(true);
+		m_spawn_content(m_pos);
 	};
 	TimedEvents::pushEvent(std::make_unique<TimedEvent>(350, SpawnContent));
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef _CHEST_INCLUDE
 #define _CHEST_INCLUDE
 
+#include <functional>
 #include "ThrowableTile.h"
 
 // Represents a chest, which is a throwable "tile" that drops some item
@@ -11,15 +12,15 @@ public:
 		 std::shared_ptr<TileMap> tilemap,
 		 glm::ivec2 tilemap_pos,
 		 std::shared_ptr<ShaderProgram> shader_program,
-		 std::shared_ptr<Entity> content);
+		 std::function<void(glm::ivec2)> spawn_content);
 
 	virtual void collideWithEntity(Collision collision) override;
 
 	virtual void onDestroy() override;
 
 private:
-	// What is inside the chest
-	std::shared_ptr<Entity> m_content;
+	// Spawns what is inside the chest at the given position
+	std::function<void(glm::ivec2)> m_spawn_content;
 };
 
 #endif // _CHEST_INCLUDE
\ No newline at end of file
@@ -26,6 +26,9 @@ public:
     // Sets whether the coin is enabled or not
     virtual void setEnabled(bool enabled) override; 
 
+    // Makes the coin big or small
+    void setBig(bool is_big);
+
     // Returns the points gained from collecting this coin
     unsigned int getPoints() const;
 
@@ -44,6 +47,9 @@ private:
 
     // True iff this coin is big, false if it is small
     bool m_is_big;
+
+    // The number of times it has been enabled. It is pooled, so the timed events of a previous use check it
+    unsigned int m_uses = 0;
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,12 @@
 
 class Entity;
 
+// Whether a collision has just started or was already going on in the last frame
+enum class ContactPhase
+{
+    Enter, Stay
+};
+
 // Stores information about a collision from the point of view of an entity (which is implicit)
 // Meaning there will only be information on the other entity
 class Collision
@@ -24,6 +30,9 @@ public:
 
     // The entity we collided with
     Entity* entity;
+
+    // Whether the collision has just started
+    ContactPhase phase = ContactPhase::Enter;
 };
 
 #endif // _COLLISION_INCLUDE
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "ContactCache.h"
+
+#include <algorithm>
+#include <utility>
+
+void ContactCache::clear()
+{
+	std::fill(m_contacts.begin(), m_contacts.end(), Contact());
+	m_used = 0;
+	m_removed = 0;
+}
+
+void ContactCache::beginFrame()
+{
+	++m_frame;
+}
+
+ContactPhase ContactCache::touch(Entity* first, Entity* second)
+{
+	// The same pair may come in any order
+	if (second < first)
+		std::swap(first, second);
+
+	// Keep at most half of the slots taken, counting removed ones, so that searches stay short
+	if ((m_used + m_removed + 1) * 2 > m_contacts.size())
+	{
+		std::size_t capacity = std::max(m_contacts.size(), S_MIN_CAPACITY);
+		while ((m_used + 1) * 4 > capacity)
+			capacity *= 2;
+
+		rehash(capacity);
+	}
+
+	std::size_t const mask = m_contacts.size() - 1;
+	std::size_t free_slot = m_contacts.size();
+
+	for (std::size_t i = hashOf(first, second); ; i = (i + 1) & mask)
+	{
+		Contact& contact = m_contacts[i];
+
+		if (contact.slot == Slot::Used && contact.first == first && contact.second == second)
+		{
+			contact.frame = m_frame;
+			return ContactPhase::Stay;
+		}
+
+		if (contact.slot == Slot::Removed && free_slot == m_contacts.size())
+			free_slot = i;
+
+		if (contact.slot == Slot::Empty)
+		{
+			if (free_slot == m_contacts.size())
+				free_slot = i;
+			else
+				--m_removed;
+
+			m_contacts[free_slot] = { first, second, m_frame, Slot::Used };
+			++m_used;
+			return ContactPhase::Enter;
+		}
+	}
+}
+
+std::size_t ContactCache::hashOf(Entity* first, Entity* second) const
+{
+	uint64_t hash = reinterpret_cast<uintptr_t>(first) * 0x9E3779B97F4A7C15ull;
+	hash ^= reinterpret_cast<uintptr_t>(second) + 0x7F4A7C159E3779B9ull + (hash << 6) + (hash >> 2);
+	hash ^= hash >> 32;
+
+	return static_cast<std::size_t>(hash) & (m_contacts.size() - 1);
+}
+
+void ContactCache::rehash(std::size_t capacity)
+{
+	m_rehash_buffer.assign(capacity, Contact());
+	std::swap(m_contacts, m_rehash_buffer);
+
+	for (auto const& contact : m_rehash_buffer)
+	{
+		if (contact.slot != Slot::Used)
+			continue;
+
+		std::size_t i = hashOf(contact.first, contact.second);
+		while (m_contacts[i].slot == Slot::Used)
+			i = (i + 1) & (capacity - 1);
+
+		m_contacts[i] = contact;
+	}
+
+	m_removed = 0;
+}
@@ -0,0 +1,112 @@
+#ifndef _CONTACT_CACHE_INCLUDE
+#define _CONTACT_CACHE_INCLUDE
+
+#include <vector>
+#include <cstdint>
+#include "Collision.h"
+
+// Remembers which pairs of entities were colliding in the last frame, so that it can tell whether a collision
+// has just started or is still going on, and which collisions ended. It is a flat open addressing hash table
+// keyed by the pair of entities that keeps its memory between frames, so it does not allocate every frame.
+class ContactCache
+{
+public:
+	ContactCache() = default;
+
+	// Forgets all contacts, for when the entities are destroyed
+	void clear();
+
+	// Starts a new frame. Contacts that are not touched during it end when it finishes
+	void beginFrame();
+
+	// Registers that both entities are colliding this frame. Returns Enter if they were not colliding in the
+	// last one, Stay otherwise
+	ContactPhase touch(Entity* first, Entity* second);
+
+	// Removes the contacts that were not touched this frame, calling on_exit(first, second) for each of them.
+	// Those for which keep(first, second) is true are kept as if they had been touched
+	template <typename Keep, typename Callable>
+	void endFrame(Keep&& keep, Callable&& on_exit);
+
+	// Removes all contacts of an entity that leaves the scene, calling on_exit(first, second) for each of them.
+	// Otherwise those kept for a sleeping entity would stay forever, and could be found again by a new entity that
+	// gets the same address
+	template <typename Callable>
+	void remove(Entity const* entity, Callable&& on_exit);
+
+private:
+	enum class Slot : uint8_t
+	{
+		Empty, Used, Removed
+	};
+
+	struct Contact
+	{
+		Entity* first = nullptr;
+		Entity* second = nullptr;
+
+		// The last frame in which the pair collided
+		uint32_t frame = 0;
+
+		Slot slot = Slot::Empty;
+	};
+
+	// Returns the slot where the search for a pair starts
+	std::size_t hashOf(Entity* first, Entity* second) const;
+
+	// Moves all contacts to a table of the given capacity, which must be a power of two, dropping removed slots
+	void rehash(std::size_t capacity);
+
+	// The table, its size is always a power of two
+	std::vector<Contact> m_contacts;
+
+	// The table used during rehashes. Both are swapped to keep their memory
+	std::vector<Contact> m_rehash_buffer;
+
+	// The number of used and removed slots
+	std::size_t m_used = 0;
+	std::size_t m_removed = 0;
+
+	// The current frame
+	uint32_t m_frame = 0;
+
+	static constexpr std::size_t S_MIN_CAPACITY = 64;
+};
+
+template <typename Keep, typename Callable>
+void ContactCache::endFrame(Keep&& keep, Callable&& on_exit)
+{
+	for (auto& contact : m_contacts)
+	{
+		if (contact.slot == Slot::Used && contact.frame != m_frame)
+		{
+			if (keep(contact.first, contact.second))
+			{
+				contact.frame = m_frame;
+				continue;
+			}
+
+			contact.slot = Slot::Removed;
+			--m_used;
+			++m_removed;
+			on_exit(contact.first, contact.second);
+		}
+	}
+}
+
+template <typename Callable>
+void ContactCache::remove(Entity const* entity, Callable&& on_exit)
+{
+	for (auto& contact : m_contacts)
+	{
+		if (contact.slot == Slot::Used && (contact.first == entity || contact.second == entity))
+		{
+			contact.slot = Slot::Removed;
+			--m_used;
+			++m_removed;
+			on_exit(contact.first, contact.second);
+		}
+	}
+}
+
+#endif // _CONTACT_CACHE_INCLUDE
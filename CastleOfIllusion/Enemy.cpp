@@ -1,6 +1,7 @@
 #include "Enemy.h"
 #include "Player.h"
 #include "TimedEvent.h"
+#include "TextureCache.h"
 
 Enemy::Enemy(glm::ivec2 pos,
 	glm::ivec2 quad_size,
@@ -14,8 +15,7 @@ Enemy::Enemy(glm::ivec2 pos,
 	m_camera = camera;
 	m_player = player;
 	m_tilemap = tilemap;
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_sprite.reset(Sprite::createSprite(
 		quad_size,
 		size_in_texture,
@@ -30,26 +30,20 @@ Enemy::Enemy(glm::ivec2 pos,
 	m_grounded = true;
 }
 
-void Enemy::update(int delta_time) 
+bool Enemy::isVisible() const
 {
-	m_was_visible = m_is_visible;
-	m_is_visible = m_camera->isVisible(m_pos, m_collision_box_size);
-
-	if (!m_is_visible)
-	{
-		if (!m_camera->isVisible(m_original_pos, m_collision_box_size)) 
-			m_pos = m_original_pos;
+	return m_camera->isVisible(m_pos, m_collision_box_size);
+}
 
-		if (m_was_visible) 
-			disable();
-	}
-	else
-	{
-		if (!m_was_visible)
-			enable();
-	}
+bool Enemy::isSpawnPointVisible() const
+{
+	return m_camera->isVisible(m_original_pos, m_collision_box_size);
+}
 
-	Entity::update(delta_time);
+std::pair<int, int> Enemy::getSpawnXRange() const
+{
+	// Same box as Camera::isVisible
+	return { m_original_pos.x - m_collision_box_size.x / 2, m_original_pos.x + m_collision_box_size.x / 2 };
 }
 
 void Enemy::collideWithEntity(Collision collision) 
@@ -94,7 +88,6 @@ void Enemy::enable()
 void Enemy::disable() 
 {
 	setEnabled(false);
-	m_pos = { 42000.0f, 42000.0f };
 	m_vel = { 0.0f, 0.0f };
 }
 
@@ -142,10 +135,8 @@ SpringHorse::SpringHorse(glm::ivec2 pos,
 	m_sprite->turnLeft();
 }
 
-void SpringHorse::update(int delta_time)
+void SpringHorse::lateUpdate(int delta_time)
 {
-	Enemy::update(delta_time);
-
 	// Enter start jumping state
 	if (m_grounded && !m_jumping && !m_dying) 
 	{
@@ -203,13 +194,14 @@ void SpringHorse::onDeath()
 ///////////////// CymbalProjectile //////////////////////
 
 CymbalProjectile::CymbalProjectile(
+	std::shared_ptr<TileMap> tilemap,
 	std::shared_ptr<ShaderProgram> shader_program,
 	std::string const& texture_path,
 	glm::vec2 size_in_texture,
 	glm::vec2 position_in_texture) 
 {
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_tilemap = tilemap;
+	m_spritesheet = TextureCache::get(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_sprite.reset(Sprite::createSprite(
 		{ 64, 64 },
 		size_in_texture,
@@ -254,14 +246,13 @@ void CymbalProjectile::setEnabled(bool enabled)
 
 	if (enabled)
 	{
-		m_can_fire = false;
+		unsigned int use = ++m_uses;
+		m_hit_something = false;
 
-		auto DisappearAfterSomeTime = [this]()
+		auto DisappearAfterSomeTime = [this, use]()
 		{
-			if (!m_hit_something)
+			if (use == m_uses && !m_hit_something)
 				setEnabled(false);
-
-			m_can_fire = true;
 		};
 		TimedEvents::pushEvent(std::make_unique<TimedEvent>(4000, DisappearAfterSomeTime));
 	}
@@ -277,7 +268,8 @@ CymbalMonkey::CymbalMonkey(glm::ivec2 pos,
 	std::string&& texture_path,
 	glm::vec2 size_in_texture,
 	std::shared_ptr<Camera> camera,
-	std::shared_ptr<Player> player)
+	std::shared_ptr<Player> player,
+	ProjectileSource projectile_source)
 	:
 	Enemy(pos,
 		glm::ivec2( 64, 64 ),
@@ -286,7 +278,8 @@ CymbalMonkey::CymbalMonkey(glm::ivec2 pos,
 		"images/Monkey.png",
 		size_in_texture,
 		camera,
-		player)
+		player),
+	m_projectile_source(std::move(projectile_source))
 {
 	m_affected_by_gravity = true;
 	m_enabled = false;
@@ -307,22 +300,13 @@ CymbalMonkey::CymbalMonkey(glm::ivec2 pos,
 	m_sprite->addKeyframe(ATTACKING, { 1.0f, 0.0f });
 
 	m_sprite->changeAnimation(PLAYING);
-
-	m_projectile.reset(
-		new CymbalProjectile (
-			shader_program, 
-			std::move(texture_path),
-			{ 0.25f, 1.0f },
-			{ 0.5f, 0.0f }
-	));
-	m_projectile->m_tilemap = m_tilemap;
 }
 
 void CymbalMonkey::update(int delta_time) 
 {
-	Enemy::update(delta_time);
+	Entity::update(delta_time);
 
-	if (m_projectile->canBeFired() && !m_dying) 
+	if (m_can_fire && !m_dying) 
 	{
 		if (!m_firing) 
 		{
@@ -337,9 +321,21 @@ void CymbalMonkey::update(int delta_time)
 				m_firing = false;
 				m_sprite->changeAnimation(ATTACKING);
 
-				m_projectile->setPosition(m_pos - glm::ivec2(m_collision_box_size.x, 0.0f));
-				m_projectile->setVelocity({ -0.125f, 0.0f });
-				m_projectile->setEnabled(true);
+				m_projectile = m_projectile_source();
+				if (m_projectile)
+				{
+					m_projectile->setPosition(m_pos - glm::ivec2(m_collision_box_size.x, 0.0f));
+					m_projectile->setVelocity({ -0.125f, 0.0f });
+					m_projectile->setEnabled(true);
+					m_projectile_use = m_projectile->getUses();
+
+					m_can_fire = false;
+					auto Reload = [this]()
+					{
+						m_can_fire = true;
+					};
+					TimedEvents::pushEvent(std::make_unique<TimedEvent>(s_fire_cooldown, Reload));
+				}
 
 				auto ReturnToBaseAnimation = [this]() 
 				{
@@ -379,5 +375,8 @@ void CymbalMonkey::onDeath()
 	m_can_collide = false;
 	m_can_collide_with_tiles = false;
 	m_affected_by_gravity = true;
-	m_projectile->setEnabled(false);
+
+	// Unless the projectile is already gone and someone else has fired it
+	if (m_projectile && m_projectile->getUses() == m_projectile_use)
+		m_projectile->setEnabled(false);
 }
\ No newline at end of file
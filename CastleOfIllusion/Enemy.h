@@ -4,6 +4,7 @@
 #include "Entity.h"
 #include "Camera.h"
 #include <iostream>
+#include <functional>
 
 class Enemy : public Entity 
 {
@@ -17,10 +18,17 @@ public:
 		std::shared_ptr<Camera> camera,
 		std::shared_ptr<Player> player);
 
-	virtual void update(int delta_time) override;
-
 	virtual void collideWithEntity(Collision collision) override;
 
+	// Returns true iff the camera sees the enemy where it is now
+	bool isVisible() const;
+
+	// Returns true iff the camera sees the enemy's spawn point
+	bool isSpawnPointVisible() const;
+
+	// Returns the horizontal extent (min x, max x) of the collision box at the spawn point
+	std::pair<int, int> getSpawnXRange() const;
+
 	// Defines behaviour on death
 	virtual void onDeath() = 0;
 
@@ -29,6 +37,8 @@ public:
 	unsigned int getPoints() const { return m_points_given; }
 
 protected:
+	friend class SpawnManager;
+
 	// Called when the enemy is enabled (visible, etc)
 	virtual void enable();
 
@@ -41,12 +51,6 @@ protected:
 	// The player
 	std::shared_ptr<Player> m_player;
 
-	// True iff the enemy was visible last frame
-	bool m_was_visible = false;
-
-	// True iff the enemy is visible this frame
-	bool m_is_visible = false;
-
 	// True iff the enemy has been attacked, reset when respawned
 	bool m_dying = false;
 
@@ -68,7 +72,7 @@ public:
 		std::shared_ptr<Camera> camera,
 		std::shared_ptr<Player> player);
 
-	virtual void update(int delta_time) override;
+	virtual void lateUpdate(int delta_time) override;
 
 protected:
 	virtual void enable() override;
@@ -91,11 +95,12 @@ private:
 };
 
 // A projectile produced by the monkey's gong
-// Has a limited lifetime, manage with TimedEvent
+// Has a limited lifetime, manage with TimedEvent. They are pooled by the scene and shared by all monkeys
 class CymbalProjectile : public Entity 
 {
 public:
-	CymbalProjectile(std::shared_ptr<ShaderProgram> shader_program,
+	CymbalProjectile(std::shared_ptr<TileMap> tilemap,
+		std::shared_ptr<ShaderProgram> shader_program,
 		std::string const& texture_path,
 		glm::vec2 size_in_texture,
 		glm::vec2 position_in_texture);
@@ -108,35 +113,35 @@ public:
 
 	virtual EntityType getType() const override { return EntityType::Projectile; }
 
-	// Returns whether the projectile can be fired or not
-	bool canBeFired() const { return m_can_fire; }
+	// Returns the number of times it has been fired, to tell whether it has been fired again by someone else
+	unsigned int getUses() const { return m_uses; }
 
 private:
-	friend class CymbalMonkey;
-
 	// True iff the projectile has hit something
 	bool m_hit_something = false;
 
-	// True iff the projectile can be fired
-	bool m_can_fire = true;
+	// The number of times it has been enabled. The timed events of a previous use check it
+	unsigned int m_uses = 0;
 };
 
 // A monkey with a gong
 class CymbalMonkey : public Enemy 
 {
 public:
+	// Hands out a projectile to fire, already in the scene, or nullptr if there is none available
+	using ProjectileSource = std::function<std::shared_ptr<CymbalProjectile>()>;
+
 	CymbalMonkey(glm::ivec2 pos,
 		std::shared_ptr<TileMap> tilemap,
 		std::shared_ptr<ShaderProgram> shader_program,
 		std::string&& texture_path,
 		glm::vec2 size_in_texture,
 		std::shared_ptr<Camera> camera,
-		std::shared_ptr<Player> player);
+		std::shared_ptr<Player> player,
+		ProjectileSource projectile_source);
 
 	virtual void update(int delta_time) override;
 
-	std::shared_ptr<Entity> getProjectile() const { return m_projectile; }
-
 protected:
 	virtual void enable() override;
 
@@ -153,8 +158,18 @@ private:
 		COUNT
 	};
 	
-	// The projectile
+	// Where projectiles come from
+	ProjectileSource m_projectile_source;
+
+	// The last projectile fired, and its number of uses when it was fired
 	std::shared_ptr<CymbalProjectile> m_projectile;
+	unsigned int m_projectile_use = 0;
+
+	// Time between shots
+	static constexpr int s_fire_cooldown = 4000;
+
+	// True iff the monkey can fire again
+	bool m_can_fire = true;
 
 	// True iff firing the projectile
 	bool m_firing = false;
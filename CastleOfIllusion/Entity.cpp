@@ -3,6 +3,30 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+
+Entity::Entity()
+    : m_body(PhysicsBodies::create()),
+      m_pos(PhysicsBodies::position(m_body)),
+      m_previous_pos(PhysicsBodies::previousPosition(m_body)),
+      m_pending_displacement(PhysicsBodies::displacement(m_body)),
+      m_has_pending_movement(PhysicsBodies::pending(m_body)),
+      m_vel(PhysicsBodies::velocity(m_body)),
+      m_acc(PhysicsBodies::acceleration(m_body)),
+      m_can_collide_with_tiles(PhysicsBodies::collidesWithTiles(m_body)),
+      m_affected_by_gravity(PhysicsBodies::affectedByGravity(m_body)),
+      m_bounces(PhysicsBodies::bounces(m_body)),
+      m_affected_by_x_drag(PhysicsBodies::affectedByXDrag(m_body)),
+      m_grounded(PhysicsBodies::grounded(m_body)),
+      M_MAX_X_VELOCITY(PhysicsBodies::maxXVelocity(m_body)),
+      M_MAX_FALL_VELOCITY(PhysicsBodies::maxFallVelocity(m_body))
+{
+}
+
+Entity::~Entity()
+{
+    PhysicsBodies::destroy(m_body);
+}
 
 void Entity::update(int delta_time)
 {
@@ -11,101 +35,89 @@ void Entity::update(int delta_time)
 
     m_sprite->update(delta_time);
 
-    // Update Y position
-    if (m_affected_by_gravity) 
-    {
-        // Only apply max velocity when falling, gravity will do the other case for us
-        if (m_vel.y > 0)
-        {
-            float new_vel = m_vel.y + S_GRAVITY * static_cast<float>(delta_time);
-            if (abs(new_vel) < M_MAX_FALL_VELOCITY)
-                m_vel.y = new_vel;
-        }
-        else
-            m_vel.y += S_GRAVITY * static_cast<float>(delta_time);
-    }
-    m_pos.y += static_cast<int>(m_vel.y * static_cast<float>(delta_time));
+    // The velocity is updated and the movement done later by the scene, together with all other entities
+    m_has_pending_movement = true;
+}
+
+TileBody Entity::getTileBody() const
+{
+    TileBody body;
+    body.pos = getMinMaxCollisionCoords().first;
+    body.size = m_collision_box_size;
+    body.velocity = m_vel;
+
+    // The collision box is rounded from the position, so it is rounded again after moving
+    float half_width = m_collision_box_size.x / 2.f;
+    body.displacement.x = static_cast<int>(m_pos.x + m_pending_displacement.x - half_width) - body.pos.x;
+    body.displacement.y = m_pending_displacement.y;
 
-    if (m_can_collide_with_tiles)
+    body.collides = m_can_collide_with_tiles;
+
+    // A throwable tile that breaks when hitting the floor doesn't go on moving. Breaking zeroes its velocity and
+    // turns off its collisions with tiles, and throwables have no acceleration, so the horizontal step that would
+    // follow could not move it anyway; skipping it keeps the displacement computed before it broke from applying
+    body.stops_on_y_impact = m_is_throwable && static_cast<ThrowableTile const*>(this)->breaksOnImpact();
+
+    return body;
+}
+
+void Entity::applyTileBody(TileBody const& body)
+{
+    m_has_pending_movement = false;
+
+    if (body.y_impact)
     {
-        auto y_collision = m_tilemap->yCollision(getMinMaxCollisionCoords().first, m_collision_box_size, m_vel);
-        if (y_collision)
+        m_pos.y = body.pos.y + m_collision_box_size.y;
+        m_acc.y = 0.0f;
+
+        if (m_bounces)
         {
-            m_pos.y = y_collision->y + m_collision_box_size.y;
-            m_acc.y = 0.0f;
-
-            if (m_bounces)
-            {
-                m_vel.y *= S_BOUNCE_COEFF;
-                if (abs(m_vel.y) <= S_MIN_BOUNCE_SPEED)
-                    m_vel.y = 0.0f;
-            }
-            else
+            m_vel.y *= S_BOUNCE_COEFF;
+            if (std::abs(m_vel.y) <= S_MIN_BOUNCE_SPEED)
                 m_vel.y = 0.0f;
-
-            // This is a bit of a hack, but it is way more comfortable to check for this here since
-            // we progressively update the position
-            if (auto throwable = dynamic_cast<ThrowableTile*>(this)) 
-            {
-                if (throwable->isBeingThrown()) 
-                {
-                    if (throwable->isDestroyedOnImpact())
-                        throwable->onDestroy();
-                    else
-                        throwable->m_thrown = false;
-                }
-            }   
         }
+        else
+            m_vel.y = 0.0f;
 
-        m_grounded = m_tilemap->isGrounded(getMinMaxCollisionCoords().first, m_collision_box_size);
+        if (m_is_throwable)
+            static_cast<ThrowableTile*>(this)->onLanding();
     }
+    else
+        m_pos.y += m_pending_displacement.y;
 
-    // Update X position
-    float new_vel = m_vel.x + m_acc.x * static_cast<float>(delta_time);
-    if (abs(new_vel) < M_MAX_X_VELOCITY)
-        m_vel.x = new_vel;
+    if (body.collides)
+        m_grounded = body.grounded;
 
-    if (m_affected_by_x_drag) 
+    if (body.y_impact && body.stops_on_y_impact)
     {
-        if (m_vel.x > 0) 
-            m_vel.x = std::max(m_vel.x - S_X_DRAG * static_cast<float>(delta_time), 0.0f);
-        else if (m_vel.x < 0)
-            m_vel.x = std::min(m_vel.x + S_X_DRAG * static_cast<float>(delta_time), 0.0f);
+        m_sprite->setPosition(m_pos);
+        return;
     }
 
-    m_pos.x += m_vel.x * static_cast<float>(delta_time);
-
-    if (m_can_collide_with_tiles)
+    if (body.x_impact)
     {
-        auto x_collision = m_tilemap->xCollision(getMinMaxCollisionCoords().first, m_collision_box_size, m_vel);
-        if (x_collision)
+        m_pos.x = body.pos.x + m_collision_box_size.x / 2;
+
+        if (m_bounces)
         {
-            m_pos.x = x_collision->x + m_collision_box_size.x / 2;
-
-            if (m_bounces)
-            {
-                m_vel.x *= S_BOUNCE_COEFF;
-                if (abs(m_vel.x) <= S_MIN_BOUNCE_SPEED)
-                    m_vel.x = 0.0f;
-            }
-
-            // This is a bit of a hack, but it is way more comfortable to check for this here since
-            // we progressively update the position
-            if (auto throwable = dynamic_cast<ThrowableTile*>(this))
-            {
-                if (throwable->isBeingThrown() && throwable->isDestroyedOnImpact())
-                    throwable->onDestroy();
-            }
+            m_vel.x *= S_BOUNCE_COEFF;
+            if (std::abs(m_vel.x) <= S_MIN_BOUNCE_SPEED)
+                m_vel.x = 0.0f;
         }
+
+        if (m_is_throwable)
+            static_cast<ThrowableTile*>(this)->onWallImpact();
     }
+    else
+        m_pos.x += m_pending_displacement.x;
 
     m_sprite->setPosition(m_pos);
 }
 
-void Entity::render()
+void Entity::render(SpriteBatch& batch)
 {
     if (m_enabled)
-        m_sprite->render();
+        m_sprite->render(batch);
 }
 
 void Entity::changePosition(glm::ivec2 change)
@@ -224,18 +236,8 @@ void Entity::computeCollisionAgainstSolid(Entity* solid)
             m_pos.y -= y_inside_up;
             m_grounded = true;
 
-            // This is a bit of a hack, but it is way more comfortable to check for this here since
-            // we progressively update the position
-            if (auto throwable = dynamic_cast<ThrowableTile*>(this))
-            {
-                if (throwable->isBeingThrown())
-                {
-                    if (throwable->isDestroyedOnImpact())
-                        throwable->onDestroy();
-                    else
-                        throwable->m_thrown = false;
-                }
-            }
+            if (m_is_throwable)
+                static_cast<ThrowableTile*>(this)->onLanding();
         }
         else
             m_pos.y += y_inside_down;
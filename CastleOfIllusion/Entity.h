@@ -6,6 +6,7 @@
 #include "TileMap.h"
 #include "Collision.h"
 #include "EntityType.h"
+#include "PhysicsBodies.h"
 #include <memory>
 
 // Represents a game entity, that is, something that is dynamic, has a position, could move and
@@ -13,13 +14,34 @@
 class Entity
 {
 public:
+    // Creates the entity with a new physics body in PhysicsBodies
+    Entity();
+
+    // Frees the physics body
+    virtual ~Entity();
+
+    Entity(Entity const& other) = delete;
+    Entity& operator=(Entity const& other) = delete;
+
     // vec2 are non const reference because they are only 8 bytes
 
-    // Updates the entity
+    // Updates the entity and its velocity. The movement is left pending, the scene moves all entities at once
     virtual void update(int delta_time);
 
-    // Renders the entity
-    virtual void render();
+    // Called after all entities have moved, for what depends on the new position
+    virtual void lateUpdate(int delta_time) {}
+
+    // Returns true iff the last update left a movement to be done
+    bool hasPendingMovement() const { return m_has_pending_movement; }
+
+    // Returns the pending movement, to be resolved by TileMap::resolveBodies
+    TileBody getTileBody() const;
+
+    // Moves the entity to where TileMap::resolveBodies left the body and reacts to the impacts
+    void applyTileBody(TileBody const& body);
+
+    // Adds the entity to the batch of sprites being rendered
+    virtual void render(SpriteBatch& batch);
 
     // Adds the given vector to the entity's position
     virtual void changePosition(glm::ivec2 change);
@@ -48,9 +70,16 @@ public:
     // Returns (minX,minY) and (maxX,maxY) of the collision box
     std::pair<glm::ivec2, glm::ivec2> getMinMaxCollisionCoords() const;
 
-    // Called when the entity collides with something
+    // Called when the entity collides with something, every frame while they collide unless
+    // m_receives_collision_stay is false, in which case only in the first one
     virtual void collideWithEntity(Collision collision) = 0;
 
+    // Called when the entity stops colliding with something
+    virtual void stopCollidingWithEntity(Entity* entity) {}
+
+    // Returns true iff collideWithEntity has to be called every frame of a collision and not only in the first one
+    bool receivesCollisionStay() const { return m_receives_collision_stay; }
+
     // Returns true iff this Entity is colliding with other
     bool operator&(Entity const& other) const;
 
@@ -58,11 +87,23 @@ public:
     std::pair<Collision, Collision> operator|(Entity const& other) const;
 
     // Returns true iff the entity can be processed for collision detection
-    inline bool canCollide() const { return m_enabled && m_can_collide; }
+    inline bool canCollide() const { return m_enabled && m_can_collide && !m_dormant; }
 
     // Returns true iff the entity is enabled
     inline bool isEnabled() const { return m_enabled; }
 
+    // Returns true iff the entity is asleep because it is far from the camera, so it is not updated nor collides
+    inline bool isDormant() const { return m_dormant; }
+
+    // Returns true iff the entity has to be updated even when it is far from the camera
+    inline bool isAlwaysActive() const { return m_always_active; }
+
+    // Puts the entity to sleep or wakes it up. Its state is kept as is while it sleeps
+    void setDormant(bool dormant) { m_dormant = dormant; }
+
+    // Returns true iff the entity is a ThrowableTile
+    inline bool isThrowable() const { return m_is_throwable; }
+
     // Sets whether the entity can collide or not
     void setCollisions (bool can_collide) { m_can_collide = can_collide; }
 
@@ -77,6 +118,9 @@ protected:
     // Updates the position according to the collision box of the solid
     void computeCollisionAgainstSolid(Entity* solid);
 
+    // The index of the physics body in PhysicsBodies. The physics fields below are references to it
+    std::size_t m_body;
+
     // The spritesheet
     std::shared_ptr<Texture> m_spritesheet;
 	
@@ -87,24 +131,33 @@ protected:
     std::shared_ptr<TileMap> m_tilemap;
 
     // The coordinates of the midpoint in the base of the Entity
-    glm::ivec2 m_pos;
+    glm::ivec2& m_pos;
 
     // (re)spawn position
     glm::ivec2 m_original_pos;
+
+    // The position before the last movement
+    glm::ivec2& m_previous_pos;
+
+    // The movement left by the last update
+    glm::ivec2& m_pending_displacement;
+
+    // True iff the movement left by the last update has not been done yet
+    bool& m_has_pending_movement;
   
     // The x and y sizes of the collision box
     glm::ivec2 m_collision_box_size;
   
     // The velocity
-    glm::vec2 m_vel;
+    glm::vec2& m_vel;
 
     // The acceleration
-    glm::vec2 m_acc {0.0f, 0.0f};
+    glm::vec2& m_acc;
 
-    constexpr static float S_GRAVITY = 0.006f;
+    constexpr static float S_GRAVITY = PhysicsBodies::S_GRAVITY;
 
     // True iff this entity can collide with the tilemap
-    bool m_can_collide_with_tiles = true;
+    bool& m_can_collide_with_tiles;
 
     // True iff this entity can collide with other entities. Disable for destroy or fading animations, for instance
     bool m_can_collide = true;
@@ -112,8 +165,20 @@ protected:
     // True iff this entity is enabled (is processed by the game)
     bool m_enabled = true;
 
+    // True iff collideWithEntity is called every frame of a collision, false if only the first one matters
+    bool m_receives_collision_stay = true;
+
+    // True iff this entity is asleep because it is outside the scene's activity region
+    bool m_dormant = false;
+
+    // True iff this entity never sleeps, for the player and whatever has to go on acting out of view
+    bool m_always_active = false;
+
+    // True iff this is a ThrowableTile, so that the physics can call its impact hooks without RTTI
+    bool m_is_throwable = false;
+
     // True iff this entity is affected by gravity
-    bool m_affected_by_gravity = false;
+    bool& m_affected_by_gravity;
 
     // The bouncing coefficient
     static constexpr float S_BOUNCE_COEFF = -0.7f;
@@ -122,22 +187,19 @@ protected:
     static constexpr float S_MIN_BOUNCE_SPEED = 0.25f;
 
     // True iff this entity is affected by bouncing
-    bool m_bounces = false;
-
-    // The x drag coefficient
-    static constexpr float S_X_DRAG = 0.003f;
+    bool& m_bounces;
 
     // True iff the entity is affected by drag on the X axis
-    bool m_affected_by_x_drag = false;
+    bool& m_affected_by_x_drag;
 
     // True iff the entity's "feet" are on the floor
-    bool m_grounded = false;
+    bool& m_grounded;
 
     // The maximum |velocity| on the X axis
-    float M_MAX_X_VELOCITY = 10.0f;
+    float& M_MAX_X_VELOCITY;
 
     // The maximum fall velocity (ie. maximum velocity on the Y axis)
-    float M_MAX_FALL_VELOCITY = 10.0f;
+    float& M_MAX_FALL_VELOCITY;
 };
 
 #endif // _ENTITY_INCLUDE
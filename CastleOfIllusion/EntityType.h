@@ -3,6 +3,7 @@
 
 #include <ostream>
 #include <string>
+#include <array>
 
 enum class EntityType 
 {
@@ -17,9 +18,73 @@ enum class EntityType
 	ThrowableTile,
 	Void,
 	Gem,
-	CameraPoint
+	CameraPoint,
+	Count // Always keep this one last
 };
 
+// Table telling, for each pair of types, if entities of those types do anything when they collide.
+// It is the union of what the collideWithEntity of both types handles, so any pair whose switches would both
+// end in default is false and can be skipped without even testing the collision boxes.
+// Unknown is kept true with everything to be safe
+using InteractionMatrix = std::array<std::array<bool, static_cast<std::size_t>(EntityType::Count)>, static_cast<std::size_t>(EntityType::Count)>;
+
+constexpr InteractionMatrix makeInteractionMatrix()
+{
+	InteractionMatrix matrix{};
+
+	auto Interact = [&matrix](EntityType first, EntityType second)
+	{
+		matrix[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)] = true;
+		matrix[static_cast<std::size_t>(second)][static_cast<std::size_t>(first)] = true;
+	};
+
+	for (std::size_t type = 0; type < static_cast<std::size_t>(EntityType::Count); ++type)
+		Interact(EntityType::Unknown, static_cast<EntityType>(type));
+
+	Interact(EntityType::Player, EntityType::Enemy);
+	Interact(EntityType::Player, EntityType::Projectile);
+	Interact(EntityType::Player, EntityType::Coin);
+	Interact(EntityType::Player, EntityType::Cake);
+	Interact(EntityType::Player, EntityType::Gem);
+	Interact(EntityType::Player, EntityType::ThrowableTile);
+	Interact(EntityType::Player, EntityType::Platform);
+	Interact(EntityType::Player, EntityType::Void);
+	Interact(EntityType::Player, EntityType::CameraPoint);
+
+	Interact(EntityType::Enemy, EntityType::ThrowableTile);
+	Interact(EntityType::Enemy, EntityType::Platform);
+
+	Interact(EntityType::Boss, EntityType::ThrowableTile);
+
+	// Cymbal projectiles and boss blocks
+	Interact(EntityType::Projectile, EntityType::ThrowableTile);
+	Interact(EntityType::Projectile, EntityType::Platform);
+	Interact(EntityType::Projectile, EntityType::Void);
+
+	Interact(EntityType::Platform, EntityType::Coin);
+	Interact(EntityType::Platform, EntityType::Cake);
+	Interact(EntityType::Platform, EntityType::ThrowableTile);
+	Interact(EntityType::Platform, EntityType::Void);
+	Interact(EntityType::Platform, EntityType::CameraPoint);
+
+	Interact(EntityType::ThrowableTile, EntityType::ThrowableTile);
+	Interact(EntityType::ThrowableTile, EntityType::CameraPoint);
+
+	return matrix;
+}
+
+inline constexpr InteractionMatrix S_INTERACTION_MATRIX = makeInteractionMatrix();
+
+// Returns true iff entities of these types can do something when colliding with each other
+constexpr bool canInteract(EntityType first, EntityType second)
+{
+	return S_INTERACTION_MATRIX[static_cast<std::size_t>(first)][static_cast<std::size_t>(second)];
+}
+
+static_assert(!canInteract(EntityType::CameraPoint, EntityType::Coin), "Camera points do nothing with coins");
+static_assert(!canInteract(EntityType::Void, EntityType::Void), "Voids do nothing with each other");
+static_assert(canInteract(EntityType::Player, EntityType::Void), "The player falls off in voids");
+
 inline std::string toString(EntityType type) 
 {
 	switch (type) 
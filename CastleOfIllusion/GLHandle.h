@@ -0,0 +1,114 @@
+#ifndef _GL_HANDLE_INCLUDE
+#define _GL_HANDLE_INCLUDE
+
+
+#include <utility>
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+
+// Owns an OpenGL object and deletes it when it goes out of scope or gets replaced, so that nothing outlives the
+// class it belongs to. It can be moved but not copied, each object has exactly one owner.
+// Without a GPU (HEADLESS) objects are never created, the id stays 0 and nothing is deleted
+template<typename Traits>
+class GLHandle
+{
+
+public:
+	GLHandle() = default;
+
+	// Takes ownership of an object created elsewhere, like the ones glCreateProgram returns
+	explicit GLHandle(GLuint id) : m_id(id) {}
+
+	~GLHandle() { reset(); }
+
+	GLHandle(GLHandle const& other) = delete;
+	GLHandle& operator=(GLHandle const& other) = delete;
+
+	GLHandle(GLHandle&& other) noexcept : m_id(std::exchange(other.m_id, 0)) {}
+
+	GLHandle& operator=(GLHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_id = std::exchange(other.m_id, 0);
+		}
+		return *this;
+	}
+
+	// Creates a new object of the kind the traits describe
+	// Should be called with an active OpenGL context
+	static GLHandle generate()
+	{
+		GLHandle handle;
+#ifndef HEADLESS
+		Traits::generate(handle.m_id);
+#endif
+		return handle;
+	}
+
+	// Deletes the object, if any
+	void reset()
+	{
+#ifndef HEADLESS
+		if (m_id != 0)
+			Traits::destroy(m_id);
+#endif
+		m_id = 0;
+	}
+
+	// Returns the OpenGL ID of the object, or 0 if there is none
+	GLuint get() const { return m_id; }
+
+	// Returns true iff there is an object
+	explicit operator bool() const { return m_id != 0; }
+
+private:
+	// The OpenGL ID of the object
+	GLuint m_id = 0;
+
+};
+
+
+// How each kind of object is created and deleted
+
+struct GLBufferTraits
+{
+	static void generate(GLuint& id) { glGenBuffers(1, &id); }
+	static void destroy(GLuint id) { glDeleteBuffers(1, &id); }
+};
+
+struct GLVertexArrayTraits
+{
+	static void generate(GLuint& id) { glGenVertexArrays(1, &id); }
+	static void destroy(GLuint id) { glDeleteVertexArrays(1, &id); }
+};
+
+struct GLTextureTraits
+{
+	static void generate(GLuint& id) { glGenTextures(1, &id); }
+	static void destroy(GLuint id) { glDeleteTextures(1, &id); }
+};
+
+// Shaders and programs are created with glCreateShader and glCreateProgram, whose IDs are given to the constructor
+
+struct GLShaderTraits
+{
+	static void destroy(GLuint id) { glDeleteShader(id); }
+};
+
+struct GLProgramTraits
+{
+	static void destroy(GLuint id) { glDeleteProgram(id); }
+};
+
+
+using GLBuffer = GLHandle<GLBufferTraits>;
+using GLVertexArray = GLHandle<GLVertexArrayTraits>;
+using GLTexture = GLHandle<GLTextureTraits>;
+using GLShader = GLHandle<GLShaderTraits>;
+using GLProgram = GLHandle<GLProgramTraits>;
+
+
+#endif // _GL_HANDLE_INCLUDE
@@ -1,14 +1,18 @@
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include "Game.h"
 
 void Game::init()
 {
 	instance().m_is_playing = true;
-	glClearColor(0.53f, 0.77f, 1.0f, 1.0f);
+	setClearColor(0.53f, 0.77f, 1.0f);
 	instance().m_scene.init();
 }
 
+void Game::free()
+{
+	instance().m_scene.free();
+}
+
 bool Game::update(int delta_time)
 {
 	instance().m_scene.update(delta_time);
@@ -18,8 +22,17 @@ bool Game::update(int delta_time)
 
 void Game::render()
 {
+#ifndef HEADLESS
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	instance().m_scene.render();
+#endif
+}
+
+void Game::setClearColor(float red, float green, float blue)
+{
+#ifndef HEADLESS
+	glClearColor(red, green, blue, 1.0f);
+#endif
 }
 
 void Game::keyPressed(int key)
@@ -19,6 +19,9 @@ public:
 	// Initializes the game
 	static void init();
 
+	// Releases everything the game holds on the GPU, before the OpenGL context is destroyed
+	static void free();
+
 	// Updates the game, and returns true if it should keep running
 	static bool update(int delta_time);
 
@@ -43,6 +46,12 @@ public:
 	// Gets if a certain key is pressed in the state
 	static bool getKey(int key);
 
+	// Sets the background color. Does nothing in headless builds
+	static void setClearColor(float red, float green, float blue);
+
+	// Gets the scene, used by drivers that step the game without a window
+	static Scene& getScene() { return instance().m_scene; }
+
 private:
 	// Constructor defaults to private for the singleton pattern
 	Game() = default;
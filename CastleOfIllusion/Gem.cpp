@@ -1,5 +1,6 @@
 #include "Gem.h"
 #include "TimedEvent.h"
+#include "TextureCache.h"
 
 Gem::Gem(glm::ivec2 const& pos,
     std::shared_ptr<TileMap> tilemap,
@@ -7,8 +8,7 @@ Gem::Gem(glm::ivec2 const& pos,
 {
     m_tilemap = tilemap;
 
-    m_spritesheet.reset(new Texture());
-    m_spritesheet->loadFromFile("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
+    m_spritesheet = TextureCache::get("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
     m_sprite.reset(Sprite::createSprite(glm::ivec2(tilemap->getTileSize(), 
         tilemap->getTileSize()) /* quad_size */,
         {0.125f, 0.5f},
@@ -22,6 +22,7 @@ Gem::Gem(glm::ivec2 const& pos,
     m_collision_box_size = glm::ivec2(tilemap->getTileSize(), tilemap->getTileSize());
 
     m_bounces = true;
+    m_receives_collision_stay = false;
     m_affected_by_gravity = false;
     m_affected_by_x_drag = false;
     m_can_collide = true;
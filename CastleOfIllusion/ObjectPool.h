@@ -0,0 +1,97 @@
+#ifndef _OBJECT_POOL_INCLUDE
+#define _OBJECT_POOL_INCLUDE
+
+#include <vector>
+#include <memory>
+
+// A set of entities of the same type, with their sprites and textures, created when the level is read and
+// handed out at runtime, so that spawning them in the middle of a frame doesn't allocate anything.
+// An object is in use from acquire() until it is disabled, then collect() takes it back. Objects have to be
+// enabled right after acquiring them, and their setEnabled(true) has to reset whatever their last use left.
+template <typename T>
+class ObjectPool
+{
+public:
+	ObjectPool() = default;
+
+	// Removes all objects
+	void clear();
+
+	// Adds a free object to the pool
+	void add(std::shared_ptr<T> object);
+
+	// Hands out a free object, or nullptr if all of them are in use
+	std::shared_ptr<T> acquire();
+
+	// Takes back the objects in use that have been disabled, calling on_release(object) for each of them
+	template <typename Callable>
+	void collect(Callable&& on_release);
+
+	// Returns the number of objects in use
+	std::size_t inUse() const { return m_in_use.size(); }
+
+	// Returns the number of objects in the pool
+	std::size_t size() const { return m_objects.size(); }
+
+private:
+	// All objects
+	std::vector<std::shared_ptr<T>> m_objects;
+
+	// The indices of the free objects and of those in use
+	std::vector<std::size_t> m_free;
+	std::vector<std::size_t> m_in_use;
+};
+
+template <typename T>
+void ObjectPool<T>::clear()
+{
+	m_objects.clear();
+	m_free.clear();
+	m_in_use.clear();
+}
+
+template <typename T>
+void ObjectPool<T>::add(std::shared_ptr<T> object)
+{
+	m_free.push_back(m_objects.size());
+	m_objects.push_back(std::move(object));
+
+	// So that taking objects from one list to the other never allocates
+	m_in_use.reserve(m_objects.size());
+}
+
+template <typename T>
+std::shared_ptr<T> ObjectPool<T>::acquire()
+{
+	if (m_free.empty())
+		return nullptr;
+
+	std::size_t index = m_free.back();
+	m_free.pop_back();
+	m_in_use.push_back(index);
+
+	return m_objects[index];
+}
+
+template <typename T>
+template <typename Callable>
+void ObjectPool<T>::collect(Callable&& on_release)
+{
+	for (std::size_t i = 0; i < m_in_use.size();)
+	{
+		std::size_t index = m_in_use[i];
+		if (m_objects[index]->isEnabled())
+		{
+			++i;
+			continue;
+		}
+
+		on_release(m_objects[index]);
+
+		m_in_use[i] = m_in_use.back();
+		m_in_use.pop_back();
+		m_free.push_back(index);
+	}
+}
+
+#endif // _OBJECT_POOL_INCLUDE
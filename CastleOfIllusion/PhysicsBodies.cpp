@@ -0,0 +1,309 @@
+#include "PhysicsBodies.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// SSE2 is always there on x64, AVX2 only when the compiler is told so (/arch:AVX2 or -mavx2)
+#if defined(__AVX2__)
+#define PHYSICS_BODIES_SIMD
+#define PHYSICS_BODIES_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_BODIES_SIMD
+#include <emmintrin.h>
+#endif
+
+std::size_t PhysicsBodies::create()
+{
+	auto& bodies = instance();
+
+	std::size_t body;
+	if (!bodies.m_free.empty())
+	{
+		body = bodies.m_free.back();
+		bodies.m_free.pop_back();
+	}
+	else
+	{
+		body = bodies.m_size++;
+		if (body / S_CHUNK_SIZE == bodies.m_chunks.size())
+			bodies.m_chunks.emplace_back(new Chunk());
+	}
+
+	position(body) = glm::ivec2(0, 0);
+	previousPosition(body) = glm::ivec2(0, 0);
+	displacement(body) = glm::ivec2(0, 0);
+	velocity(body) = glm::vec2(0.0f, 0.0f);
+	acceleration(body) = glm::vec2(0.0f, 0.0f);
+	maxXVelocity(body) = 10.0f;
+	maxFallVelocity(body) = 10.0f;
+	pending(body) = false;
+	collidesWithTiles(body) = true;
+	affectedByGravity(body) = false;
+	affectedByXDrag(body) = false;
+	bounces(body) = false;
+	grounded(body) = false;
+
+	return body;
+}
+
+void PhysicsBodies::destroy(std::size_t body)
+{
+	pending(body) = false;
+	instance().m_free.push_back(body);
+}
+
+void PhysicsBodies::integrate(int delta_time)
+{
+	auto& bodies = instance();
+
+	for (std::size_t i = 0; i < bodies.m_chunks.size(); ++i)
+	{
+		std::size_t count = std::min(S_CHUNK_SIZE, bodies.m_size - i * S_CHUNK_SIZE);
+
+#ifdef PHYSICS_BODIES_SIMD
+		if (bodies.m_vectorized)
+		{
+			// Unused bodies are never pending, so the last group of 8 can be done whole
+			integrateVectorized(*bodies.m_chunks[i], (count + 7) / 8 * 8, delta_time);
+			continue;
+		}
+#endif
+
+		integrateScalar(*bodies.m_chunks[i], 0, count, delta_time);
+	}
+}
+
+void PhysicsBodies::integrateScalar(Chunk& chunk, std::size_t first, std::size_t count, int delta_time)
+{
+	float const dt = static_cast<float>(delta_time);
+
+	for (std::size_t i = first; i < first + count; ++i)
+	{
+		if (!chunk.pending[i])
+			continue;
+
+		glm::vec2& vel = chunk.velocity[i];
+
+		// Update Y velocity
+		if (chunk.affected_by_gravity[i])
+		{
+			// Only apply max velocity when falling, gravity will do the other case for us
+			if (vel.y > 0)
+			{
+				float new_vel = vel.y + S_GRAVITY * dt;
+				if (std::abs(new_vel) < chunk.max_fall_velocity[i])
+					vel.y = new_vel;
+			}
+			else
+				vel.y += S_GRAVITY * dt;
+		}
+
+		// Update X velocity
+		float new_vel = vel.x + chunk.acceleration[i].x * dt;
+		if (std::abs(new_vel) < chunk.max_x_velocity[i])
+			vel.x = new_vel;
+
+		if (chunk.affected_by_x_drag[i])
+		{
+			if (vel.x > 0)
+				vel.x = std::max(vel.x - S_X_DRAG * dt, 0.0f);
+			else if (vel.x < 0)
+				vel.x = std::min(vel.x + S_X_DRAG * dt, 0.0f);
+		}
+
+		glm::ivec2 const& pos = chunk.position[i];
+		chunk.previous_position[i] = pos;
+		chunk.displacement[i].y = static_cast<int>(vel.y * dt);
+		chunk.displacement[i].x = static_cast<int>(pos.x + vel.x * dt) - pos.x;
+	}
+}
+
+#ifdef PHYSICS_BODIES_SIMD
+
+// The vectorized kernel follows the scalar one operation by operation, with the same float operations in the
+// same order, so that both give exactly the same bits. This needs the compiler not to fuse the multiplications
+// and additions of the scalar path, which MSVC does not do by default and GCC does not do with -ffp-contract=off.
+// Branches become selections between both results with the masks of their conditions, and std::max(x, 0) and
+// std::min(x, 0) are written as the comparisons they do, since the max and min instructions treat -0 differently.
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float) && sizeof(glm::ivec2) == 2 * sizeof(int), "Packed vectors are expected");
+
+#ifdef PHYSICS_BODIES_AVX2
+
+namespace
+{
+	using Floats = __m256;
+	using Ints = __m256i;
+
+	// Returns the x and y of 8 consecutive vec2 in separate registers
+	inline void loadPairs(float const* pairs, Floats& x, Floats& y)
+	{
+		// Each lane ends up with bodies 0 1 4 5 and 2 3 6 7, which the permutation puts back in order
+		Floats first = _mm256_loadu_ps(pairs);
+		Floats second = _mm256_loadu_ps(pairs + 8);
+		x = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+		y = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	// Writes x and y as 8 consecutive vec2, only for the bodies in mask
+	inline void storePairs(float* pairs, Floats x, Floats y, Floats mask)
+	{
+		Floats low = _mm256_unpacklo_ps(x, y);
+		Floats high = _mm256_unpackhi_ps(x, y);
+		Floats first = _mm256_permute2f128_ps(low, high, 0x20);
+		Floats second = _mm256_permute2f128_ps(low, high, 0x31);
+
+		Floats first_mask = _mm256_permute2f128_ps(_mm256_unpacklo_ps(mask, mask), _mm256_unpackhi_ps(mask, mask), 0x20);
+		Floats second_mask = _mm256_permute2f128_ps(_mm256_unpacklo_ps(mask, mask), _mm256_unpackhi_ps(mask, mask), 0x31);
+
+		_mm256_storeu_ps(pairs, _mm256_blendv_ps(_mm256_loadu_ps(pairs), first, first_mask));
+		_mm256_storeu_ps(pairs + 8, _mm256_blendv_ps(_mm256_loadu_ps(pairs + 8), second, second_mask));
+	}
+
+	inline Floats loadFloats(float const* values) { return _mm256_loadu_ps(values); }
+
+	// Returns a mask with all bits set for the true flags among 8
+	inline Floats loadMask(bool const* flags)
+	{
+		Ints bytes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(flags)));
+		return _mm256_castsi256_ps(_mm256_cmpgt_epi32(bytes, _mm256_setzero_si256()));
+	}
+
+	inline Floats set(float value) { return _mm256_set1_ps(value); }
+	inline Floats zero() { return _mm256_setzero_ps(); }
+	inline Floats add(Floats a, Floats b) { return _mm256_add_ps(a, b); }
+	inline Floats sub(Floats a, Floats b) { return _mm256_sub_ps(a, b); }
+	inline Floats mul(Floats a, Floats b) { return _mm256_mul_ps(a, b); }
+	inline Floats bitAnd(Floats a, Floats b) { return _mm256_and_ps(a, b); }
+	inline Floats bitOr(Floats a, Floats b) { return _mm256_or_ps(a, b); }
+	inline Floats bitNot(Floats a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	inline Floats less(Floats a, Floats b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	inline Floats greater(Floats a, Floats b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	inline Floats abs(Floats a) { return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF))); }
+	inline Floats select(Floats mask, Floats if_true, Floats if_false) { return _mm256_blendv_ps(if_false, if_true, mask); }
+	inline Floats toFloats(Ints a) { return _mm256_cvtepi32_ps(a); }
+	inline Ints truncate(Floats a) { return _mm256_cvttps_epi32(a); }
+	inline Ints subInts(Ints a, Ints b) { return _mm256_sub_epi32(a, b); }
+	inline Floats asFloats(Ints a) { return _mm256_castsi256_ps(a); }
+	inline Ints asInts(Floats a) { return _mm256_castps_si256(a); }
+
+	constexpr std::size_t S_WIDTH = 8;
+}
+
+#else
+
+namespace
+{
+	using Floats = __m128;
+	using Ints = __m128i;
+
+	// Returns the x and y of 4 consecutive vec2 in separate registers
+	inline void loadPairs(float const* pairs, Floats& x, Floats& y)
+	{
+		Floats first = _mm_loadu_ps(pairs);
+		Floats second = _mm_loadu_ps(pairs + 4);
+		x = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+		y = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+
+	inline Floats select(Floats mask, Floats if_true, Floats if_false) { return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false)); }
+
+	// Writes x and y as 4 consecutive vec2, only for the bodies in mask
+	inline void storePairs(float* pairs, Floats x, Floats y, Floats mask)
+	{
+		_mm_storeu_ps(pairs, select(_mm_unpacklo_ps(mask, mask), _mm_unpacklo_ps(x, y), _mm_loadu_ps(pairs)));
+		_mm_storeu_ps(pairs + 4, select(_mm_unpackhi_ps(mask, mask), _mm_unpackhi_ps(x, y), _mm_loadu_ps(pairs + 4)));
+	}
+
+	inline Floats loadFloats(float const* values) { return _mm_loadu_ps(values); }
+
+	// Returns a mask with all bits set for the true flags among 4
+	inline Floats loadMask(bool const* flags)
+	{
+		int32_t packed;
+		std::memcpy(&packed, flags, sizeof(packed));
+		Ints bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), _mm_setzero_si128()), _mm_setzero_si128());
+		return _mm_castsi128_ps(_mm_cmpgt_epi32(bytes, _mm_setzero_si128()));
+	}
+
+	inline Floats set(float value) { return _mm_set1_ps(value); }
+	inline Floats zero() { return _mm_setzero_ps(); }
+	inline Floats add(Floats a, Floats b) { return _mm_add_ps(a, b); }
+	inline Floats sub(Floats a, Floats b) { return _mm_sub_ps(a, b); }
+	inline Floats mul(Floats a, Floats b) { return _mm_mul_ps(a, b); }
+	inline Floats bitAnd(Floats a, Floats b) { return _mm_and_ps(a, b); }
+	inline Floats bitOr(Floats a, Floats b) { return _mm_or_ps(a, b); }
+	inline Floats bitNot(Floats a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+	inline Floats less(Floats a, Floats b) { return _mm_cmplt_ps(a, b); }
+	inline Floats greater(Floats a, Floats b) { return _mm_cmpgt_ps(a, b); }
+	inline Floats abs(Floats a) { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+	inline Floats toFloats(Ints a) { return _mm_cvtepi32_ps(a); }
+	inline Ints truncate(Floats a) { return _mm_cvttps_epi32(a); }
+	inline Ints subInts(Ints a, Ints b) { return _mm_sub_epi32(a, b); }
+	inline Floats asFloats(Ints a) { return _mm_castsi128_ps(a); }
+	inline Ints asInts(Floats a) { return _mm_castps_si128(a); }
+
+	constexpr std::size_t S_WIDTH = 4;
+}
+
+#endif
+
+void PhysicsBodies::integrateVectorized(Chunk& chunk, std::size_t count, int delta_time)
+{
+	float const dt_scalar = static_cast<float>(delta_time);
+	Floats const dt = set(dt_scalar);
+	Floats const gravity = set(S_GRAVITY * dt_scalar);
+	Floats const drag = set(S_X_DRAG * dt_scalar);
+
+	// 8 bodies per iteration, in one AVX2 register or two SSE2 ones
+	for (std::size_t group = 0; group < count; group += 8)
+	{
+		for (std::size_t i = group; i < group + 8; i += S_WIDTH)
+		{
+			Floats pending = loadMask(&chunk.pending[i]);
+			Floats affected_by_gravity = loadMask(&chunk.affected_by_gravity[i]);
+			Floats affected_by_x_drag = loadMask(&chunk.affected_by_x_drag[i]);
+
+			Floats vel_x, vel_y;
+			loadPairs(&chunk.velocity[i].x, vel_x, vel_y);
+
+			Floats acc_x, acc_y;
+			loadPairs(&chunk.acceleration[i].x, acc_x, acc_y);
+
+			Floats pos_x, pos_y;
+			loadPairs(reinterpret_cast<float const*>(&chunk.position[i].x), pos_x, pos_y);
+
+			// Update Y velocity: the limit only applies when falling
+			Floats new_vel_y = add(vel_y, gravity);
+			Floats falling = greater(vel_y, zero());
+			Floats below_limit = less(abs(new_vel_y), loadFloats(&chunk.max_fall_velocity[i]));
+			Floats apply_gravity = bitAnd(affected_by_gravity, bitOr(bitNot(falling), below_limit));
+			vel_y = select(apply_gravity, new_vel_y, vel_y);
+
+			// Update X velocity
+			Floats new_vel_x = add(vel_x, mul(acc_x, dt));
+			vel_x = select(less(abs(new_vel_x), loadFloats(&chunk.max_x_velocity[i])), new_vel_x, vel_x);
+
+			Floats moving_right = greater(vel_x, zero());
+			Floats moving_left = less(vel_x, zero());
+			Floats dragged_right = sub(vel_x, drag);
+			Floats dragged_left = add(vel_x, drag);
+			dragged_right = select(less(dragged_right, zero()), zero(), dragged_right);
+			dragged_left = select(greater(dragged_left, zero()), zero(), dragged_left);
+			vel_x = select(bitAnd(affected_by_x_drag, moving_right), dragged_right, select(bitAnd(affected_by_x_drag, moving_left), dragged_left, vel_x));
+
+			// Compute the displacement
+			Ints pos_x_ints = asInts(pos_x);
+			Ints displacement_x = subInts(truncate(add(toFloats(pos_x_ints), mul(vel_x, dt))), pos_x_ints);
+			Ints displacement_y = truncate(mul(vel_y, dt));
+
+			storePairs(&chunk.velocity[i].x, vel_x, vel_y, pending);
+			storePairs(reinterpret_cast<float*>(&chunk.previous_position[i].x), pos_x, pos_y, pending);
+			storePairs(reinterpret_cast<float*>(&chunk.displacement[i].x), asFloats(displacement_x), asFloats(displacement_y), pending);
+		}
+	}
+}
+
+#endif // PHYSICS_BODIES_SIMD
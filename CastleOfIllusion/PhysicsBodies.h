@@ -0,0 +1,106 @@
+#ifndef _PHYSICS_BODIES_INCLUDE
+#define _PHYSICS_BODIES_INCLUDE
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+
+// Stores the physics state of every entity (position, velocity, acceleration and the physics flags) as a
+// structure of arrays, so that the integration of all bodies is a linear sweep over contiguous memory instead
+// of a walk through every entity allocation. Each entity holds the index of its body.
+//
+// The arrays are split in fixed size chunks that are never moved, so that entities can keep references to their
+// fields. Freed bodies are reused by the next entity that is created.
+class PhysicsBodies
+{
+public:
+	// Gravity, in pixels per millisecond squared
+	static constexpr float S_GRAVITY = 0.006f;
+
+	// The x drag coefficient
+	static constexpr float S_X_DRAG = 0.003f;
+
+	// Creates a body with the default state and returns its index
+	static std::size_t create();
+
+	// Frees a body so that its index can be reused
+	static void destroy(std::size_t body);
+
+	// Updates the velocity of all bodies marked as pending and computes the displacement they have to do
+	static void integrate(int delta_time);
+
+	// Chooses between the vectorized integration (the default where SSE2 is available) and the scalar one.
+	// Both give exactly the same results
+	static void setVectorized(bool vectorized) { instance().m_vectorized = vectorized; }
+
+	// Accessors to the fields of a body
+	static glm::ivec2& position(std::size_t body) { return chunk(body).position[body % S_CHUNK_SIZE]; }
+	static glm::ivec2& previousPosition(std::size_t body) { return chunk(body).previous_position[body % S_CHUNK_SIZE]; }
+	static glm::ivec2& displacement(std::size_t body) { return chunk(body).displacement[body % S_CHUNK_SIZE]; }
+	static glm::vec2& velocity(std::size_t body) { return chunk(body).velocity[body % S_CHUNK_SIZE]; }
+	static glm::vec2& acceleration(std::size_t body) { return chunk(body).acceleration[body % S_CHUNK_SIZE]; }
+	static float& maxXVelocity(std::size_t body) { return chunk(body).max_x_velocity[body % S_CHUNK_SIZE]; }
+	static float& maxFallVelocity(std::size_t body) { return chunk(body).max_fall_velocity[body % S_CHUNK_SIZE]; }
+	static bool& pending(std::size_t body) { return chunk(body).pending[body % S_CHUNK_SIZE]; }
+	static bool& collidesWithTiles(std::size_t body) { return chunk(body).collides_with_tiles[body % S_CHUNK_SIZE]; }
+	static bool& affectedByGravity(std::size_t body) { return chunk(body).affected_by_gravity[body % S_CHUNK_SIZE]; }
+	static bool& affectedByXDrag(std::size_t body) { return chunk(body).affected_by_x_drag[body % S_CHUNK_SIZE]; }
+	static bool& bounces(std::size_t body) { return chunk(body).bounces[body % S_CHUNK_SIZE]; }
+	static bool& grounded(std::size_t body) { return chunk(body).grounded[body % S_CHUNK_SIZE]; }
+
+private:
+	static constexpr std::size_t S_CHUNK_SIZE = 256;
+
+	// The state of S_CHUNK_SIZE bodies, one array per field
+	struct Chunk
+	{
+		glm::ivec2 position[S_CHUNK_SIZE];
+		glm::ivec2 previous_position[S_CHUNK_SIZE];
+		glm::ivec2 displacement[S_CHUNK_SIZE];
+		glm::vec2 velocity[S_CHUNK_SIZE];
+		glm::vec2 acceleration[S_CHUNK_SIZE];
+		float max_x_velocity[S_CHUNK_SIZE];
+		float max_fall_velocity[S_CHUNK_SIZE];
+
+		// True iff the body has been updated this frame and has not moved yet
+		bool pending[S_CHUNK_SIZE];
+
+		bool collides_with_tiles[S_CHUNK_SIZE];
+		bool affected_by_gravity[S_CHUNK_SIZE];
+		bool affected_by_x_drag[S_CHUNK_SIZE];
+		bool bounces[S_CHUNK_SIZE];
+		bool grounded[S_CHUNK_SIZE];
+	};
+
+	// The instance is never destroyed, since entities owned by other singletons (ie. the scene in Game) free their
+	// bodies at exit, possibly after the static objects created before them have been destroyed
+	static PhysicsBodies& instance()
+	{
+		static PhysicsBodies* instance = new PhysicsBodies();
+		return *instance;
+	}
+	PhysicsBodies() = default;
+
+	static Chunk& chunk(std::size_t body) { return *instance().m_chunks[body / S_CHUNK_SIZE]; }
+
+	// Integrates the bodies of a chunk from first to first + count, one at a time
+	static void integrateScalar(Chunk& chunk, std::size_t first, std::size_t count, int delta_time);
+
+	// Integrates the first count bodies of a chunk, 8 at a time. The flags are turned into masks so that there
+	// are no branches, and bodies that are not pending are computed but not written
+	static void integrateVectorized(Chunk& chunk, std::size_t count, int delta_time);
+
+	// The chunks, only the last one may be partially used
+	std::vector<std::unique_ptr<Chunk>> m_chunks;
+
+	// The number of bodies ever created, used or not
+	std::size_t m_size = 0;
+
+	// The bodies that have been destroyed, to be reused
+	std::vector<std::size_t> m_free;
+
+	// True iff integrateVectorized is used
+	bool m_vectorized = true;
+};
+
+#endif // _PHYSICS_BODIES_INCLUDE
@@ -3,6 +3,7 @@
 #include "Player.h"
 
 #include <iostream>
+#include <algorithm>
 
 Platform::Platform(glm::ivec2 pos, std::shared_ptr<Texture> tilesheet, int tile_size, std::shared_ptr<ShaderProgram> shader_program, std::shared_ptr<TileMap> tilemap)
 {
@@ -32,10 +33,15 @@ void Platform::update(int delta_time)
     if (!m_enabled)
         return;
 
-    glm::ivec2 previous_pos = m_pos;
     Entity::update(delta_time);
+}
+
+void Platform::lateUpdate(int delta_time)
+{
+    if (!m_enabled)
+        return;
 
-    glm::ivec2 change_in_position = m_pos - previous_pos;
+    glm::ivec2 change_in_position = m_pos - m_previous_pos;
     bool pos_changed = (change_in_position != glm::ivec2(0, 0));
 
     if (pos_changed) 
@@ -43,8 +49,6 @@ void Platform::update(int delta_time)
         for (auto entity : m_entities_on_top)
             entity->changePosition(change_in_position);
     }
-
-    m_entities_on_top.clear();
 }
 
 void Platform::collideWithEntity(Collision collision)
@@ -81,7 +85,8 @@ void Platform::collideWithEntity(Collision collision)
     case EntityType::Coin:
     case EntityType::Cake:
     {
-        m_entities_on_top.push_back(collision.entity);
+        if (collision.phase == ContactPhase::Enter)
+            m_entities_on_top.push_back(collision.entity);
         break;
     }
     case EntityType::Void:
@@ -92,6 +97,13 @@ void Platform::collideWithEntity(Collision collision)
     }
 }
 
+void Platform::stopCollidingWithEntity(Entity* entity)
+{
+    auto it = std::find(m_entities_on_top.begin(), m_entities_on_top.end(), entity);
+    if (it != m_entities_on_top.end())
+        m_entities_on_top.erase(it);
+}
+
 void Platform::setEnabled(bool enabled) 
 {
     Entity::setEnabled(enabled);
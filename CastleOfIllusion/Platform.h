@@ -17,16 +17,21 @@ public:
 
     virtual void update(int delta_time) override;
 
+    virtual void lateUpdate(int delta_time) override;
+
     // Gets the entity's type
     virtual EntityType getType() const override { return EntityType::Platform; }
 
     // Called when the entity collides with something
     virtual void collideWithEntity(Collision collision) override;
 
+    // Called when the entity stops colliding with something
+    virtual void stopCollidingWithEntity(Entity* entity) override;
+
     virtual void setEnabled(bool enabled) override;
 
 private:
-    // All entities on top of the platform each frame
+    // All entities on top of the platform, added when they start colliding with it and removed when they stop
     std::vector<Entity*> m_entities_on_top;
 
     // True iff the player has stoop on top of it; starts falling
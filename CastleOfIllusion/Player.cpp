@@ -12,6 +12,7 @@
 #include "TimedEvent.h"
 #include "Enemy.h"
 #include "Camera.h"
+#include "TextureCache.h"
 
 #define JUMP_HEIGHT 4*16*4
 #define MAX_X_VELOCITY 0.6f // Maximum velocity on the x axis
@@ -41,6 +42,7 @@ Player::Player(glm::vec2 const& pos, std::shared_ptr<TileMap> tilemap, std::shar
 {
 	m_affected_by_x_drag = false;
 	m_affected_by_gravity = true;
+	m_always_active = true;
 	M_MAX_FALL_VELOCITY = MAX_FALL_VELOCITY;
 	M_MAX_X_VELOCITY = MAX_X_VELOCITY;
 
@@ -48,7 +50,6 @@ Player::Player(glm::vec2 const& pos, std::shared_ptr<TileMap> tilemap, std::shar
 	m_tilemap = tilemap;
 	m_ui = ui;
 	m_collision_box_size = collision_box_size;
-	m_spritesheet.reset(new Texture());
 	m_grounded = false;
 	m_vel = glm::vec2(0.f,0.f);
 	m_acc = glm::vec2(0.f,0.f);
@@ -59,7 +60,7 @@ Player::Player(glm::vec2 const& pos, std::shared_ptr<TileMap> tilemap, std::shar
 	m_ui->setPower(m_max_power);
 	m_ui->setTries(m_tries);
 
-	m_spritesheet->loadFromFile("images/MickeyMouse.png", TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get("images/MickeyMouse.png", TEXTURE_PIXEL_FORMAT_RGBA);
 
 	m_sprite.reset(Sprite::createSprite(sprite_size, glm::vec2(SIZE_IN_TEXTURE_X, SIZE_IN_TEXTURE_Y), m_spritesheet, shader_program));
 	
@@ -308,7 +309,7 @@ void Player::update(int delta_time)
 		}
 	}
 
-	// This updates the position and velocity
+	// This updates the velocity, the position is updated later
 	Entity::update(delta_time);
 
 	// Change animation if necessary
@@ -357,7 +358,10 @@ void Player::update(int delta_time)
 				break;
 		}
 	}
+}
 
+void Player::lateUpdate(int delta_time)
+{
 	// Update sprite position
 	m_sprite->setPosition(glm::vec2(static_cast<float>(m_tilemap_displ.x + m_pos.x), static_cast<float>(m_tilemap_displ.y + m_pos.y)));
 
@@ -500,7 +504,7 @@ void Player::loseTry()
 		m_camera->setPosition(m_original_pos);
 		m_camera->setOffset(3);
 		m_camera->setStatic(false);
-		glClearColor(0.53f, 0.77f, 1.0f, 1.0f);
+		Game::setClearColor(0.53f, 0.77f, 1.0f);
 
 		for (auto& reactivable : m_reactivate_on_respawn)
 		{
@@ -570,7 +574,7 @@ void Player::setChangeScreenCallback(std::function<void(Screen)> callback) {
 void Player::changeScreen(Screen scene_id) {
 	if (m_change_scene_callback) {
 		m_change_scene_callback(scene_id);
-		glClearColor(0.53f, 0.77f, 1.0f, 1.0f);
+		Game::setClearColor(0.53f, 0.77f, 1.0f);
 	}
 }
 
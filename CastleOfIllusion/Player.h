@@ -48,6 +48,9 @@ public:
     // Updates the player
     virtual void update(int delta_time) final override;
 
+    // Moves the sprite and the object being held along with the player
+    virtual void lateUpdate(int delta_time) final override;
+
     // Called when the player collides with something
     virtual void collideWithEntity(Collision collision) final override;
 
@@ -21,6 +21,7 @@
 #include "Rock.h"
 #include "Box.h"
 #include "CameraPoint.h"
+#include "TextureCache.h"
 
 // Tilemap top left screen position
 #define SCREEN_X 0
@@ -30,9 +31,25 @@ void Scene::init()
 {
 	m_tilemap.reset();
 	m_player.reset();
+	m_screen_cache.clear();
 	m_tex_program.reset(new ShaderProgram());
+	m_tile_program.reset(new ShaderProgram());
 
+#ifndef HEADLESS
 	initShaders();
+#endif
+	m_projection_uniform = m_tex_program->getUniform("projection");
+	m_color_uniform = m_tex_program->getUniform("color");
+	m_tile_projection_uniform = m_tile_program->getUniform("projection");
+	m_tile_color_uniform = m_tile_program->getUniform("color");
+	m_sprite_batch.init(m_tex_program);
+
+	// Sheets drawn in the same frames share an atlas, so that a level frame binds a single texture
+	TextureCache::loadAtlas({ "images/Scene.png", "images/MickeyMouse.png", "images/Horse.png", "images/Monkey.png",
+		"images/Items.png", "images/Boss.png", "images/Blocks2.png", "images/UIBase.png", "images/Numbers.png" },
+		TEXTURE_PIXEL_FORMAT_RGBA);
+	TextureCache::loadAtlas({ "images/StartScreen.png", "images/StartScreenText.png", "images/arrow.png",
+		"images/ControlsScreen.png", "images/CreditsScreen.png" }, TEXTURE_PIXEL_FORMAT_RGBA);
 
 	m_ui.reset(new UI());
 	m_ui->init(m_tex_program, Screen::StrartScreen);
@@ -48,6 +65,33 @@ void Scene::init()
 	m_current_time = 0.0f;
 }
 
+void Scene::free()
+{
+	TimedEvents::clearEvents();
+
+	m_entities.clear();
+	m_spawns.clear();
+	m_coin_pool.clear();
+	m_cake_pool.clear();
+	m_projectile_pool.clear();
+	m_static_triggers.clear();
+	m_contacts.clear();
+	m_player.reset();
+	m_boss.reset();
+	m_gem.reset();
+	m_camera.reset();
+	m_ui.reset();
+	m_tilemap.reset();
+	m_screen_cache.clear();
+
+	m_sprite_batch.free();
+	m_tex_program.reset();
+	m_tile_program.reset();
+
+	// Nothing uses the textures anymore
+	TextureCache::clear();
+}
+
 void Scene::update(int delta_time)
 {
 	m_current_time += delta_time;
@@ -71,31 +115,53 @@ void Scene::update(int delta_time)
 	case Screen::Tutorial:
 	case Screen::Level:
 	{
+		// Take back the pooled entities that have been picked up or have disappeared
+		auto release = [this](auto const& object) { removeEntity(object.get()); };
+		m_coin_pool.collect(release);
+		m_cake_pool.collect(release);
+		m_projectile_pool.collect(release);
+
+		// Enemies appear when their spawn point comes into view and leave when they go out of it
+		m_spawns.update(*m_camera,
+			[this](std::shared_ptr<Enemy> const& enemy) { addEntity(enemy); },
+			[this](std::shared_ptr<Enemy> const& enemy) { removeEntity(enemy.get()); });
+
+		// Entities far from the camera sleep, they are neither updated nor collide
+		updateActivity();
+
 		// This includes the player, which is first of all
 		for (auto& entity : m_entities)
 		{
-			entity->update(delta_time);
+			if (!entity->isDormant())
+				entity->update(delta_time);
 		}
 
-		// Check collisions between entities (each pair once)
-		for (std::size_t i = 0; i < m_entities.size(); ++i)
+		// Gravity, drag and velocity limits for all entities that have been updated
+		PhysicsBodies::integrate(delta_time);
+
+		moveEntities();
+
+		for (auto& entity : m_entities)
 		{
-			if (!m_entities[i]->canCollide())
-				continue;
+			if (!entity->isDormant())
+				entity->lateUpdate(delta_time);
+		}
 
-			for (std::size_t j = i + 1; j < m_entities.size(); ++j)
+		m_contacts.beginFrame();
+		checkCollisions();
+		checkTriggerCollisions();
+
+		// Let the entities know about the collisions that have ended. Those of a sleeping entity are kept
+		// until it wakes up, to find things as they were
+		m_contacts.endFrame([](Entity* first, Entity* second)
 			{
-				if (!m_entities[j]->canCollide())
-					continue;
-
-				if (*m_entities[i] & *m_entities[j])
-				{
-					auto&& [i_collision, j_collision] = *m_entities[i] | *m_entities[j];
-					m_entities[i]->collideWithEntity(i_collision);
-					m_entities[j]->collideWithEntity(j_collision);
-				}
-			}
-		}
+				return first->isDormant() || second->isDormant();
+			},
+			[](Entity* first, Entity* second)
+			{
+				first->stopCollidingWithEntity(second);
+				second->stopCollidingWithEntity(first);
+			});
 		break;
 	}
 	case Screen::Options:
@@ -115,17 +181,209 @@ void Scene::update(int delta_time)
 	m_ui->update(delta_time);
 }
 
+void Scene::setBroadphase(BroadphaseType broadphase)
+{
+	m_broadphase = broadphase;
+}
+
+void Scene::addEntity(std::shared_ptr<Entity> entity)
+{
+	m_entity_types.push_back(entity->getType());
+	m_trigger_queries.emplace_back();
+	m_entities.push_back(std::move(entity));
+}
+
+void Scene::removeEntity(Entity const* entity)
+{
+	// Its collisions end now, even those kept while either side was sleeping
+	m_contacts.remove(entity, [](Entity* first, Entity* second)
+		{
+			first->stopCollidingWithEntity(second);
+			second->stopCollidingWithEntity(first);
+		});
+
+	// Keeps the order of the rest, so that the player stays first
+	for (std::size_t i = 0; i < m_entities.size(); ++i)
+	{
+		if (m_entities[i].get() == entity)
+		{
+			m_entities.erase(m_entities.begin() + i);
+			m_entity_types.erase(m_entity_types.begin() + i);
+			m_trigger_queries.erase(m_trigger_queries.begin() + i);
+			return;
+		}
+	}
+}
+
+void Scene::setActivityMargin(int margin)
+{
+	m_activity_margin = margin;
+}
+
+void Scene::updateActivity()
+{
+	glm::ivec2 margin(m_activity_margin, m_activity_margin);
+	glm::ivec2 region_min = glm::ivec2(m_camera->getPosition()) - margin;
+	glm::ivec2 region_max = glm::ivec2(m_camera->getPosition() + m_camera->getSize()) + margin;
+
+	for (auto& entity : m_entities)
+	{
+		if (m_activity_margin < 0 || entity->isAlwaysActive())
+		{
+			entity->setDormant(false);
+			continue;
+		}
+
+		auto [min, max] = entity->getMinMaxCollisionCoords();
+		entity->setDormant(max.x < region_min.x || min.x > region_max.x || max.y < region_min.y || min.y > region_max.y);
+	}
+}
+
+void Scene::moveEntities()
+{
+	m_moving_entities.clear();
+	m_tile_bodies.clear();
+
+	for (auto& entity : m_entities)
+	{
+		if (entity->hasPendingMovement())
+		{
+			m_moving_entities.push_back(entity.get());
+			m_tile_bodies.push_back(entity->getTileBody());
+		}
+	}
+
+	// All the tile collisions are resolved in one go
+	m_tilemap->resolveBodies(m_tile_bodies);
+
+	for (std::size_t i = 0; i < m_moving_entities.size(); ++i)
+		m_moving_entities[i]->applyTileBody(m_tile_bodies[i]);
+}
+
+void Scene::checkCollisions()
+{
+	switch (m_broadphase)
+	{
+	case BroadphaseType::NestedLoop:
+	{
+		// Test each pair once
+		for (std::size_t i = 0; i < m_entities.size(); ++i)
+		{
+			if (!m_entities[i]->canCollide())
+				continue;
+
+			for (std::size_t j = i + 1; j < m_entities.size(); ++j)
+			{
+				if (canInteract(m_entity_types[i], m_entity_types[j]) && m_entities[j]->canCollide())
+					collideEntities(*m_entities[i], *m_entities[j]);
+			}
+		}
+		return;
+	}
+	case BroadphaseType::SpatialHash:
+		m_spatial_hash.findPairs(m_entities, m_collision_pairs);
+		break;
+	case BroadphaseType::SweepAndPrune:
+		m_sweep_and_prune.findPairs(m_entities, m_collision_pairs);
+		break;
+	}
+
+	std::size_t current_i = m_entities.size();
+	bool i_can_collide = false;
+	for (auto const& [i, j] : m_collision_pairs)
+	{
+		if (!canInteract(m_entity_types[i], m_entity_types[j]))
+			continue;
+
+		// Whether the first entity can collide is checked once per entity, like the nested loop does,
+		// because collisions may change it
+		if (i != current_i)
+		{
+			current_i = i;
+			i_can_collide = m_entities[i]->canCollide();
+		}
+
+		if (i_can_collide && m_entities[j]->canCollide())
+			collideEntities(*m_entities[i], *m_entities[j]);
+	}
+}
+
+void Scene::checkTriggerCollisions()
+{
+	if (m_static_triggers.empty())
+		return;
+
+	for (std::size_t i = 0; i < m_entities.size(); ++i)
+	{
+		TriggerQuery& last_query = m_trigger_queries[i];
+		Entity& entity = *m_entities[i];
+		EntityType type = m_entity_types[i];
+
+		if (!entity.canCollide() || !(canInteract(type, EntityType::Void) || canInteract(type, EntityType::CameraPoint)))
+		{
+			last_query.valid = false;
+			continue;
+		}
+
+		auto [min, max] = entity.getMinMaxCollisionCoords();
+
+		// Nothing can have changed if the entity did not move and was not touching any trigger. While it
+		// touches one the query is repeated every frame, since triggers may be enabled again at any moment
+		if (last_query.valid && !last_query.touching && last_query.min == min && last_query.max == max)
+			continue;
+
+		last_query.valid = true;
+		last_query.touching = false;
+		last_query.min = min;
+		last_query.max = max;
+
+		m_static_triggers.query(min, max, [&](Entity& trigger)
+			{
+				last_query.touching = true;
+
+				if (canInteract(type, trigger.getType()) && entity.canCollide() && trigger.canCollide())
+					collideEntities(entity, trigger);
+			});
+	}
+}
+
+void Scene::collideEntities(Entity& first, Entity& second)
+{
+	if (first & second)
+	{
+		auto&& [first_collision, second_collision] = first | second;
+		ContactPhase phase = m_contacts.touch(&first, &second);
+		first_collision.phase = phase;
+		second_collision.phase = phase;
+
+		if (phase == ContactPhase::Enter || first.receivesCollisionStay())
+			first.collideWithEntity(first_collision);
+		if (phase == ContactPhase::Enter || second.receivesCollisionStay())
+			second.collideWithEntity(second_collision);
+	}
+}
+
 void Scene::render()
 {
-	glm::mat4 modelview;
+	glm::mat4 projection;
+
+	projection = m_camera->getProjectionMatrix();
+
+	// The tile map has a program of its own, and goes below everything else
+	if (m_current_screen == Screen::Tutorial || m_current_screen == Screen::Level)
+	{
+		m_tile_program->use();
+		m_tile_program->setUniformMatrix4f(m_tile_projection_uniform, projection);
+		m_tile_program->setUniform4f(m_tile_color_uniform, 1.0f, 1.0f, 1.0f, 1.0f);
+		m_tilemap->render(m_camera->getPosition(), m_camera->getPosition() + m_camera->getSize());
+	}
 
 	m_tex_program->use();
-	m_tex_program->setUniformMatrix4f("projection", m_camera->getProjectionMatrix());
-	m_tex_program->setUniform4f("color", 1.0f, 1.0f, 1.0f, 1.0f);
-	modelview = glm::mat4(1.0f);
-	m_tex_program->setUniformMatrix4f("modelview", modelview);
-	m_tex_program->setUniform2f("texCoordDispl", 0.f, 0.f);
+	m_tex_program->setUniformMatrix4f(m_projection_uniform, projection);
+	m_tex_program->setUniform4f(m_color_uniform, 1.0f, 1.0f, 1.0f, 1.0f);
 
+	// The sprites are drawn when the batch ends or changes texture
+	m_sprite_batch.begin();
 
 	switch (m_current_screen)
 	{
@@ -135,25 +393,21 @@ void Scene::render()
 	}
 	case Screen::Tutorial:
 	{
-		m_tilemap->render();
-
 		// The player is rendered the last
 		for (int i = m_entities.size() - 1; i >= 0; --i)
 		{
 			if (m_entities[i]->isEnabled())
-				m_entities[i]->render();
+				m_entities[i]->render(m_sprite_batch);
 		}
 		break;
 	}
 	case Screen::Level:
 	{
-		m_tilemap->render();
-
 		// The player is rendered the last
 		for (int i = m_entities.size() - 1; i >= 0; --i)
 		{
 			if (m_entities[i]->isEnabled())
-				m_entities[i]->render();
+				m_entities[i]->render(m_sprite_batch);
 		}
 		break;
 	}
@@ -168,38 +422,45 @@ void Scene::render()
 
 	}
 
-	m_ui->render();
+	m_ui->render(m_sprite_batch);
+	m_sprite_batch.end();
 }
 
 void Scene::initShaders()
+{
+	initProgram(*m_tex_program, "shaders/texture.vert", "shaders/texture.frag");
+	initProgram(*m_tile_program, "shaders/tilemap.vert", "shaders/texture.frag");
+}
+
+void Scene::initProgram(ShaderProgram& program, std::string const& vertex_file, std::string const& fragment_file)
 {
 	Shader vertex_shader, fragment_shader;
 
-	vertex_shader.initFromFile(VERTEX_SHADER, "shaders/texture.vert");
+	vertex_shader.initFromFile(VERTEX_SHADER, vertex_file);
 	if(!vertex_shader.isCompiled())
 	{
 		std::cerr << "" << vertex_shader.log() << std::endl << std::endl;
 		throw std::runtime_error("Vertex Shader compilation error!");
 	}
 
-	fragment_shader.initFromFile(FRAGMENT_SHADER, "shaders/texture.frag");
+	fragment_shader.initFromFile(FRAGMENT_SHADER, fragment_file);
 	if(!fragment_shader.isCompiled())
 	{
 		std::cerr << "" << fragment_shader.log() << std::endl << std::endl;
 		throw std::runtime_error("Fragment Shader compilation error!");
 	}
 
-	m_tex_program->init();
-	m_tex_program->addShader(vertex_shader);
-	m_tex_program->addShader(fragment_shader);
-	m_tex_program->link();
-	if(!m_tex_program->isLinked())
+	program.init();
+	program.addShader(vertex_shader);
+	program.addShader(fragment_shader);
+	program.link();
+	if(!program.isLinked())
 	{
-		std::cerr << "" << m_tex_program->log() << std::endl << std::endl;
+		std::cerr << "" << program.log() << std::endl << std::endl;
 		throw std::runtime_error("Shader linking error!");
 	}
 
-	m_tex_program->bindFragmentOutput("outColor");
+	program.bindFragmentOutput("outColor");
 }
 
 void Scene::setScreen(Screen new_screen)
@@ -234,8 +495,10 @@ void Scene::changeScreen(Screen new_screen)
 		m_camera->init(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT), m_ui);
 		m_camera->setStatic(false);
 
-		m_tilemap.reset(TileMap::createTileMap("levels/tutorial.txt", glm::vec2(SCREEN_X, SCREEN_Y), *m_tex_program));
-		readSceneFile("levels/tutorial.entities");
+		auto resources = m_screen_cache.get(new_screen, [this]() { return loadScreen("levels/tutorial.txt", "levels/tutorial.entities"); });
+		m_tilemap = resources->tilemap;
+		m_spatial_hash.setCellSize(m_tilemap->getTileSize());
+		readScene(resources->entities);
 
 		m_gem->setEnabled(true);
 		break;
@@ -250,8 +513,10 @@ void Scene::changeScreen(Screen new_screen)
 		m_camera->init(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT), m_ui);
 		m_camera->setStatic(false);
 
-		m_tilemap.reset(TileMap::createTileMap("levels/normal.txt", glm::vec2(SCREEN_X, SCREEN_Y), *m_tex_program));
-		readSceneFile("levels/normal.entities");
+		auto resources = m_screen_cache.get(new_screen, [this]() { return loadScreen("levels/normal.txt", "levels/normal.entities"); });
+		m_tilemap = resources->tilemap;
+		m_spatial_hash.setCellSize(m_tilemap->getTileSize());
+		readScene(resources->entities);
 		break;
 	}
 	case Screen::Options:
@@ -280,16 +545,31 @@ void Scene::changeScreen(Screen new_screen)
 	}
 }
 
-void Scene::readSceneFile(std::string const& path)
+ScreenResources Scene::loadScreen(std::string const& level_file, std::string const& entity_file) const
 {
-	std::fstream file(path);
+	std::ifstream file(entity_file);
 
 	if (!file.is_open())
 		throw std::runtime_error("Could not read scene file!");
 
+	ScreenResources resources;
+	resources.tilemap.reset(TileMap::createTileMap(level_file, glm::vec2(SCREEN_X, SCREEN_Y), m_tile_program));
+	resources.entities.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return resources;
+}
+
+void Scene::readScene(std::string const& entities)
+{
+	std::istringstream file(entities);
 	std::string line;
 
 	m_entities.clear();
+	m_spawns.clear();
+	m_coin_pool.clear();
+	m_cake_pool.clear();
+	m_projectile_pool.clear();
+	m_static_triggers.clear();
+	m_contacts.clear();
 
 	while (getline(file, line))
 	{
@@ -327,10 +607,19 @@ void Scene::readSceneFile(std::string const& path)
 			continue;
 		else if (word != "") // Empty lines cause this
 		{
-			std::cerr << "Scene::readSceneFile: wrong word: " << word << std::endl;
+			std::cerr << "Scene::readScene: wrong word: " << word << std::endl;
 			throw std::runtime_error("");
 		}
 	}
+
+	// Types never change, so they are stored once instead of asking each entity every frame
+	m_entity_types.clear();
+	for (auto const& entity : m_entities)
+		m_entity_types.push_back(entity->getType());
+
+	m_trigger_queries.assign(m_entities.size(), TriggerQuery());
+	m_static_triggers.build();
+	m_spawns.build();
 }
 
 void Scene::createPlayer(std::istringstream& split_line) 
@@ -367,22 +656,22 @@ void Scene::createChest(std::istringstream& split_line)
 	std::string item;
 	split_line >> item;
 
-	std::shared_ptr<Entity> content;
+	std::function<void(glm::ivec2)> spawn_content;
 
 	if (item == "coin")
-		content = createCoin(split_line);
+		spawn_content = createCoin(split_line);
 	else if (item == "cake")
-		content = createCake(split_line);
+		spawn_content = createCake(split_line);
 	else
 		throw std::runtime_error("Scene::createChest: Bad content type");
 
 	pos *= m_tilemap->getTileSize();
 	pos += glm::ivec2(m_tilemap->getTileSize() / 2, 0.0f);
 
-	m_entities.emplace_back(std::make_shared<Chest>(pos, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, content));
+	m_entities.emplace_back(std::make_shared<Chest>(pos, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, std::move(spawn_content)));
 }
 
-std::shared_ptr<Coin> Scene::createCoin(std::istringstream& split_line)
+std::function<void(glm::ivec2)> Scene::createCoin(std::istringstream& split_line)
 {
 	std::string size;
 	split_line >> size;
@@ -395,13 +684,13 @@ std::shared_ptr<Coin> Scene::createCoin(std::istringstream& split_line)
 	else
 		throw std::runtime_error("Scene::createCoin: Bad coin type");
 
-	auto coin = std::make_shared<Coin>(glm::ivec2{0.0f, 0.0f}, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, is_big);
-	m_entities.push_back(coin);
+	// One for each chest, so that there are always enough
+	m_coin_pool.add(std::make_shared<Coin>(glm::ivec2{0.0f, 0.0f}, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, is_big));
 
-	return coin;
+	return [this, is_big](glm::ivec2 pos) { spawnCoin(pos, is_big); };
 }
 
-std::shared_ptr<Cake> Scene::createCake(std::istringstream& split_line) 
+std::function<void(glm::ivec2)> Scene::createCake(std::istringstream& split_line) 
 {
 	std::string size;
 	split_line >> size;
@@ -414,10 +703,44 @@ std::shared_ptr<Cake> Scene::createCake(std::istringstream& split_line)
 	else
 		throw std::runtime_error("Scene::createCake: Bad cake type");
 
-	auto cake = std::make_shared<Cake>(glm::ivec2{0.0f,0.0f}, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, is_big);
-	m_entities.push_back(cake);
+	// One for each chest, so that there are always enough
+	m_cake_pool.add(std::make_shared<Cake>(glm::ivec2{0.0f,0.0f}, m_tilemap, glm::ivec2(SCREEN_X, SCREEN_Y), m_tex_program, is_big));
 
-	return cake;
+	return [this, is_big](glm::ivec2 pos) { spawnCake(pos, is_big); };
+}
+
+template <typename T>
+std::shared_ptr<T> Scene::spawnFromPool(ObjectPool<T>& pool)
+{
+	std::shared_ptr<T> object = pool.acquire();
+	if (object)
+		addEntity(object);
+
+	return object;
+}
+
+void Scene::spawnCoin(glm::ivec2 pos, bool is_big)
+{
+	auto coin = spawnFromPool(m_coin_pool);
+	if (!coin)
+		return;
+
+	coin->setBig(is_big);
+	coin->setPosition(pos);
+	coin->setVelocity({ 0.0f, -1.5f });
+	coin->setEnabled(true);
+}
+
+void Scene::spawnCake(glm::ivec2 pos, bool is_big)
+{
+	auto cake = spawnFromPool(m_cake_pool);
+	if (!cake)
+		return;
+
+	cake->setBig(is_big);
+	cake->setPosition(pos);
+	cake->setVelocity({ 0.0f, -1.5f });
+	cake->setEnabled(true);
 }
 
 void Scene::createVoid(std::istringstream& split_line) 
@@ -430,7 +753,7 @@ void Scene::createVoid(std::istringstream& split_line)
 	upleft_corner_pos *= m_tilemap->getTileSize();
 	collision_size *= m_tilemap->getTileSize();
 
-	m_entities.emplace_back(std::make_shared<Void>(upleft_corner_pos, collision_size, m_tex_program));
+	m_static_triggers.add(std::make_shared<Void>(upleft_corner_pos, collision_size, m_tex_program));
 }
 
 void Scene::createCameraPoint(std::istringstream& split_line) 
@@ -447,7 +770,7 @@ void Scene::createCameraPoint(std::istringstream& split_line)
 	collision_size *= m_tilemap->getTileSize();
 
 	auto camera_point = std::make_shared<CameraPoint>(upleft_corner_pos, collision_size, m_camera, m_player, player_spawn_point, camera_offset, m_tex_program, id, m_boss);
-	m_entities.emplace_back(camera_point);
+	m_static_triggers.add(camera_point);
 
 	m_player->addReactivable(camera_point);
 }
@@ -488,7 +811,7 @@ void Scene::createHorse(std::istringstream& split_line)
 	pos *= m_tilemap->getTileSize();
 	pos += glm::ivec2(m_tilemap->getTileSize() / 2, 0.0f);
 
-	m_entities.emplace_back(
+	m_spawns.add(
 		std::make_shared<SpringHorse>(
 			pos, 
 			m_tilemap, 
@@ -514,10 +837,19 @@ void Scene::createMonkey(std::istringstream& split_line)
 		"images/Monkey.png",
 		glm::vec2(0.25f, 1.0f),
 		m_camera,
-		m_player);
+		m_player,
+		[this]() { return spawnFromPool(m_projectile_pool); });
+
+	// Monkeys only have one projectile flying at a time
+	m_projectile_pool.add(
+		std::make_shared<CymbalProjectile>(
+			m_tilemap,
+			m_tex_program,
+			"images/Monkey.png",
+			glm::vec2(0.25f, 1.0f),
+			glm::vec2(0.5f, 0.0f)));
 
-	m_entities.emplace_back(monkey);
-	m_entities.emplace_back(monkey->getProjectile());
+	m_spawns.add(monkey);
 }
 
 void Scene::createBoss(std::istringstream& split_line) 
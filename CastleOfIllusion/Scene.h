@@ -7,6 +7,14 @@
 #include "Player.h"
 #include "Camera.h"
 #include "UI.h"
+#include "SpatialHash.h"
+#include "SweepAndPrune.h"
+#include "StaticTriggers.h"
+#include "ContactCache.h"
+#include "SpawnManager.h"
+#include "ObjectPool.h"
+#include "SpriteBatch.h"
+#include "ScreenCache.h"
 
 class Boss;
 class Rock;
@@ -18,6 +26,9 @@ class Box;
 #define PLAYER_COLLISION_SIZE_X 16*4
 #define PLAYER_COLLISION_SIZE_Y 32*4 - 1
 
+// How far from the camera view entities are still updated, half a screen
+#define DEFAULT_ACTIVITY_MARGIN 8*16*4
+
 class Coin;
 class Cake;
 
@@ -29,6 +40,12 @@ enum class Screen
 	StrartScreen, Tutorial, Level, Options, Credits
 };
 
+// The ways of finding which pairs of entities have to be tested for collisions
+enum class BroadphaseType
+{
+	NestedLoop, SpatialHash, SweepAndPrune
+};
+
 class Scene
 {
 
@@ -38,6 +55,9 @@ public:
 	// Initializes the scene with an entity file and a level file
 	void init();
 
+	// Releases everything the scene holds on the GPU. Has to be called while the OpenGL context still exists
+	void free();
+
 	// Updates the scene
 	void update(int delta_time);
 
@@ -47,14 +67,63 @@ public:
 	// Changes the screen, it will be updated in the next frame
 	void setScreen(Screen new_screen);
 
+	// Changes how the pairs of entities to test for collisions are found
+	void setBroadphase(BroadphaseType broadphase);
+
+	// Sets how far, in pixels, from the camera view entities are still updated. The rest sleep until the
+	// camera gets close. A negative margin keeps all entities awake
+	void setActivityMargin(int margin);
+
+	// Returns all entities in the scene
+	std::vector<std::shared_ptr<Entity>> const& getEntities() const { return m_entities; }
+
+	// Returns the batch the sprites are rendered with, which keeps the counters of the last frame
+	SpriteBatch const& getSpriteBatch() const { return m_sprite_batch; }
+
+	// Returns the texture shading program
+	ShaderProgram const& getShaderProgram() const { return *m_tex_program; }
+
+	// Returns the cache of the resources of the screens visited
+	ScreenCache const& getScreenCache() const { return m_screen_cache; }
+
+	// Returns the tile map of the current level, if any
+	std::shared_ptr<TileMap> const& getTileMap() const { return m_tilemap; }
+
 private:
 	void initShaders();
 
+	// Compiles and links a program from a vertex and a fragment shader file
+	static void initProgram(ShaderProgram& program, std::string const& vertex_file, std::string const& fragment_file);
+
+	// Adds an entity to the lists of entities that are updated and collide
+	void addEntity(std::shared_ptr<Entity> entity);
+
+	// Removes an entity from the lists of entities that are updated and collide
+	void removeEntity(Entity const* entity);
+
+	// Puts to sleep the entities outside the camera view extended by the activity margin and wakes up the rest
+	void updateActivity();
+
+	// Moves all entities as their last update left pending, colliding with the tilemap
+	void moveEntities();
+
+	// Checks collisions between all entities, using the selected broadphase
+	void checkCollisions();
+
+	// Checks collisions between the entities that have moved and the static triggers
+	void checkTriggerCollisions();
+
+	// Tests a pair of entities and lets both know if they are colliding
+	void collideEntities(Entity& first, Entity& second);
+
 	// Actually changes the screen and takes care of the changes
 	void changeScreen(Screen new_screen);
 
-	// Reads from a file which entities will be on the level, with information on how to create them
-	void readSceneFile(std::string const& path);
+	// Loads the tile map of a level and the text of its entity file, which the screen cache keeps between visits
+	ScreenResources loadScreen(std::string const& level_file, std::string const& entity_file) const;
+
+	// Creates the entities of the level from the text of its entity file, with information on how to create them
+	void readScene(std::string const& entities);
 
 	// Creates a player and adds it to the scene
 	void createPlayer(std::istringstream& split_line);
@@ -62,11 +131,19 @@ private:
 	// Creates a chest and adds it to the scene
 	void createChest(std::istringstream& split_line);
 
-	// Creates a coin and adds it to the scene
-	[[nodiscard]] std::shared_ptr<Coin> createCoin(std::istringstream& split_line);
+	// Adds a coin to the pool and returns how a chest spawns it
+	[[nodiscard]] std::function<void(glm::ivec2)> createCoin(std::istringstream& split_line);
+
+	// Adds a cake to the pool and returns how a chest spawns it
+	[[nodiscard]] std::function<void(glm::ivec2)> createCake(std::istringstream& split_line);
+
+	// Takes an object from a pool and adds it to the entity lists. Returns nullptr if all of them are in use
+	template <typename T>
+	std::shared_ptr<T> spawnFromPool(ObjectPool<T>& pool);
 
-	// Creates a cake and adds it to the scene
-	[[nodiscard]] std::shared_ptr<Cake> createCake(std::istringstream& split_line);
+	// Spawns an item from its pool jumping out of a chest at the given position
+	void spawnCoin(glm::ivec2 pos, bool is_big);
+	void spawnCake(glm::ivec2 pos, bool is_big);
 
 	// Creates a camera point and adds it to the scene
 	void createCameraPoint(std::istringstream& split_line);
@@ -110,10 +187,75 @@ private:
 
 	// All entities in the scene, including the player
 	std::vector<std::shared_ptr<Entity>> m_entities;
+
+	// The type of each entity in m_entities, to look up which pairs can interact
+	std::vector<EntityType> m_entity_types;
+
+	// The entities that move this frame and their movement, kept to avoid allocating every frame
+	std::vector<Entity*> m_moving_entities;
+	std::vector<TileBody> m_tile_bodies;
+
+	// How far from the camera view entities are still updated, negative to update all of them
+	int m_activity_margin = DEFAULT_ACTIVITY_MARGIN;
+
+	// The broadphase in use
+	BroadphaseType m_broadphase = BroadphaseType::SpatialHash;
+
+	// The broadphases for the collisions between entities
+	SpatialHash m_spatial_hash;
+	SweepAndPrune m_sweep_and_prune;
+
+	// The pairs of entities that may be colliding this frame, as indices of m_entities
+	std::vector<std::pair<std::size_t, std::size_t>> m_collision_pairs;
+
+	// The pairs of entities that collided in the last frame
+	ContactCache m_contacts;
+
+	// The spawn points of the enemies, which are only in m_entities while they are active
+	SpawnManager m_spawns;
+
+	// The items in chests and the monkeys' projectiles, created when the level is read and reused. Those in
+	// use are in m_entities
+	ObjectPool<Coin> m_coin_pool;
+	ObjectPool<Cake> m_cake_pool;
+	ObjectPool<CymbalProjectile> m_projectile_pool;
+
+	// The trigger volumes that never move (voids and camera points), which are not in m_entities
+	StaticTriggers m_static_triggers;
+
+	// What each entity in m_entities found the last time it queried the static triggers
+	struct TriggerQuery
+	{
+		// Whether there is a previous query to compare with
+		bool valid = false;
+
+		// Whether the collision box touched any trigger, enabled or not
+		bool touching = false;
+
+		// The collision box used for the query
+		glm::ivec2 min;
+		glm::ivec2 max;
+	};
+	std::vector<TriggerQuery> m_trigger_queries;
 	
 	// The texture shading program
 	std::shared_ptr<ShaderProgram> m_tex_program;
 
+	// The uniforms of the texture shading program set every frame
+	UniformHandle m_projection_uniform;
+	UniformHandle m_color_uniform;
+
+	// The program that draws the tile map, and its uniforms set every frame
+	std::shared_ptr<ShaderProgram> m_tile_program;
+	UniformHandle m_tile_projection_uniform;
+	UniformHandle m_tile_color_uniform;
+
+	// Draws the sprites of the entities and the UI, one draw call per change of texture
+	SpriteBatch m_sprite_batch;
+
+	// The tile maps and entity files of the screens visited last
+	ScreenCache m_screen_cache;
+
 	std::shared_ptr<Camera> m_camera;
 
 	std::shared_ptr<Gem> m_gem;
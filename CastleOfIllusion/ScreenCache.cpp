@@ -0,0 +1,56 @@
+#include "ScreenCache.h"
+
+std::shared_ptr<ScreenResources const> ScreenCache::get(Screen screen, std::function<ScreenResources()> const& load)
+{
+	auto found = m_index.find(screen);
+	if (found != m_index.end())
+	{
+		++m_stats.hits;
+		m_entries.splice(m_entries.begin(), m_entries, found->second);
+		return found->second->resources;
+	}
+
+	++m_stats.misses;
+	auto resources = std::make_shared<ScreenResources const>(load());
+	std::size_t bytes = byteSize(*resources);
+
+	m_entries.push_front({ screen, resources, bytes });
+	m_index[screen] = m_entries.begin();
+	m_bytes += bytes;
+	evict();
+
+	return resources;
+}
+
+void ScreenCache::setBudget(std::size_t budget)
+{
+	m_budget = budget;
+	evict();
+}
+
+void ScreenCache::clear()
+{
+	m_entries.clear();
+	m_index.clear();
+	m_bytes = 0;
+}
+
+std::size_t ScreenCache::byteSize(ScreenResources const& resources)
+{
+	std::size_t bytes = resources.entities.size();
+	if (resources.tilemap)
+		bytes += resources.tilemap->getByteSize();
+	return bytes;
+}
+
+void ScreenCache::evict()
+{
+	while (m_bytes > m_budget && m_entries.size() > 1)
+	{
+		Entry const& oldest = m_entries.back();
+		m_bytes -= oldest.bytes;
+		m_index.erase(oldest.screen);
+		m_entries.pop_back();
+		++m_stats.evictions;
+	}
+}
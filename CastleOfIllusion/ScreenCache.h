@@ -0,0 +1,89 @@
+#ifndef _SCREEN_CACHE_INCLUDE
+#define _SCREEN_CACHE_INCLUDE
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include "TileMap.h"
+
+enum class Screen;
+
+// What a screen loads from disk and keeps unchanged while it is played: its tile map, already on the GPU, and the
+// text of its entity file. Entities themselves are created again from the text on every visit, since playing changes them
+struct ScreenResources
+{
+	std::shared_ptr<TileMap> tilemap;
+	std::string entities;
+};
+
+// Counters of how the screen cache has been used
+struct ScreenCacheStats
+{
+	// Visits to a screen whose resources were still loaded
+	std::size_t hits = 0;
+
+	// Visits that had to load the resources
+	std::size_t misses = 0;
+
+	// Screens forgotten to stay within the budget
+	std::size_t evictions = 0;
+};
+
+// Keeps the resources of the screens visited most recently, so that going back to one does not read and upload
+// them again. When the resources kept take more than the budget, the least recently visited screens are forgotten
+// (their resources are freed when no one else holds them), but never the one being visited
+class ScreenCache
+{
+public:
+	explicit ScreenCache(std::size_t budget = S_DEFAULT_BUDGET) : m_budget(budget) {}
+
+	// Returns the resources of the screen, calling load to get them if they are not kept
+	std::shared_ptr<ScreenResources const> get(Screen screen, std::function<ScreenResources()> const& load);
+
+	// Sets the most bytes kept, forgetting screens if needed
+	void setBudget(std::size_t budget);
+
+	// Forgets all screens
+	void clear();
+
+	// Returns the bytes taken by the resources kept
+	std::size_t getBytes() const { return m_bytes; }
+
+	// Returns the counters since the cache was created
+	ScreenCacheStats const& getStats() const { return m_stats; }
+
+	// Returns the size of the resources, both in memory and on the GPU
+	static std::size_t byteSize(ScreenResources const& resources);
+
+	// The default budget, enough for a few levels
+	static constexpr std::size_t S_DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+private:
+	// Forgets the least recently visited screens until the budget is met, except the most recent one
+	void evict();
+
+	struct Entry
+	{
+		Screen screen;
+		std::shared_ptr<ScreenResources const> resources;
+		std::size_t bytes;
+	};
+
+	// The screens kept, the most recently visited first
+	std::list<Entry> m_entries;
+
+	// Where each screen kept is in m_entries
+	std::map<Screen, std::list<Entry>::iterator> m_index;
+
+	// The most bytes kept
+	std::size_t m_budget;
+
+	// The bytes taken by the resources kept
+	std::size_t m_bytes = 0;
+
+	ScreenCacheStats m_stats;
+};
+
+#endif // _SCREEN_CACHE_INCLUDE
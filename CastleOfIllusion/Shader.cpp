@@ -5,6 +5,7 @@ using namespace std;
 
 void Shader::initFromSource(const ShaderType type, const string &source)
 {
+#ifndef HEADLESS
 	const char* source_ptr = source.c_str();
 	GLint status;
 	char buffer[512];
@@ -12,23 +13,24 @@ void Shader::initFromSource(const ShaderType type, const string &source)
 	switch(type)
 	{
 	case VERTEX_SHADER:
-		m_shader_id = glCreateShader(GL_VERTEX_SHADER);
+		m_shader = GLShader(glCreateShader(GL_VERTEX_SHADER));
 		break;
 	case FRAGMENT_SHADER:
-		m_shader_id = glCreateShader(GL_FRAGMENT_SHADER);
+		m_shader = GLShader(glCreateShader(GL_FRAGMENT_SHADER));
 		break;
 	}
 
-	if(m_shader_id == 0)
+	if(!m_shader)
 		return;
 
-	glShaderSource(m_shader_id, 1, &source_ptr, NULL);
-	glCompileShader(m_shader_id);
-	glGetShaderiv(m_shader_id, GL_COMPILE_STATUS, &status);
+	glShaderSource(m_shader.get(), 1, &source_ptr, NULL);
+	glCompileShader(m_shader.get());
+	glGetShaderiv(m_shader.get(), GL_COMPILE_STATUS, &status);
 
 	m_compiled = (status == GL_TRUE);
-	glGetShaderInfoLog(m_shader_id, 512, NULL, buffer);
+	glGetShaderInfoLog(m_shader.get(), 512, NULL, buffer);
 	m_error_log.assign(buffer);
+#endif
 }
 
 bool Shader::initFromFile(const ShaderType type, const string &filename)
@@ -42,16 +44,9 @@ bool Shader::initFromFile(const ShaderType type, const string &filename)
 	return true;
 }
 
-void Shader::free()
-{
-	glDeleteShader(m_shader_id);
-	m_shader_id = 0;
-	m_compiled = false;
-}
-
 GLuint Shader::getId() const
 {
-	return m_shader_id;
+	return m_shader.get();
 }
 
 bool Shader::isCompiled() const
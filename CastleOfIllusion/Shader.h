@@ -5,6 +5,7 @@
 #include <string>
 #include <GL/glew.h>
 #include <GL/gl.h>
+#include "GLHandle.h"
 
 
 enum ShaderType { VERTEX_SHADER, FRAGMENT_SHADER };
@@ -27,9 +28,6 @@ public:
 	Shader& operator=(Shader const& other) = delete;
 	Shader& operator=(Shader&& other) = delete;
 
-
-	~Shader() { free(); }
-
 	// These methods should be called with an active OpenGL context
 
 	// Initializes the shader with the source code
@@ -53,11 +51,8 @@ private:
 	bool loadShaderSource(const std::string &filename, std::string &shaderSource);
 
 private:
-	// Cleans up resources
-	void free();
-
-	// The OpenGL ID for this shader
-	GLuint m_shader_id = 0;
+	// The OpenGL object for this shader, deleted with it
+	GLShader m_shader;
 
 	// True iff the shader has compiled (and correctly)
 	bool m_compiled = false;
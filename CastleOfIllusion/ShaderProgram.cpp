@@ -1,52 +1,100 @@
+#include <vector>
 #include <glm/gtc/type_ptr.hpp>
 #include "ShaderProgram.h"
 
 
 void ShaderProgram::init()
 {
-	m_program_id = glCreateProgram();
+#ifndef HEADLESS
+	m_program = GLProgram(glCreateProgram());
+#endif
 }
 
 void ShaderProgram::addShader(Shader const& shader) const
 {
-	glAttachShader(m_program_id, shader.getId());
+#ifndef HEADLESS
+	glAttachShader(m_program.get(), shader.getId());
+#endif
 }
 
 void ShaderProgram::bindFragmentOutput(std::string const& output_name) const
 {
-	glBindAttribLocation(m_program_id, 0, output_name.c_str());
+#ifndef HEADLESS
+	glBindAttribLocation(m_program.get(), 0, output_name.c_str());
+#endif
 }
 
 GLint ShaderProgram::bindVertexAttribute(std::string const& attrib_name, GLint size, GLsizei stride, GLvoid *first_pointer) const
 {
-	GLint attrib_pos;
+	GLint attrib_pos = -1;
 
-	attrib_pos = glGetAttribLocation(m_program_id, attrib_name.c_str());
+#ifndef HEADLESS
+	attrib_pos = glGetAttribLocation(m_program.get(), attrib_name.c_str());
 	glVertexAttribPointer(attrib_pos, size, GL_FLOAT, GL_FALSE, stride, first_pointer);
+#endif
+
+	return attrib_pos;
+}
+
+GLint ShaderProgram::bindInstanceAttribute(std::string const& attrib_name, GLint size, GLenum type, GLsizei stride, GLvoid *first_pointer) const
+{
+	GLint attrib_pos = -1;
+
+#ifndef HEADLESS
+	attrib_pos = glGetAttribLocation(m_program.get(), attrib_name.c_str());
+	if (type == GL_FLOAT)
+		glVertexAttribPointer(attrib_pos, size, type, GL_FALSE, stride, first_pointer);
+	else
+		glVertexAttribIPointer(attrib_pos, size, type, stride, first_pointer);
+	glVertexAttribDivisor(attrib_pos, 1);
+#endif
 
 	return attrib_pos;
 }
 
 void ShaderProgram::link()
 {
+#ifndef HEADLESS
 	GLint status;
 	char buffer[512];
 
-	glLinkProgram(m_program_id);
-	glGetProgramiv(m_program_id, GL_LINK_STATUS, &status);
+	glLinkProgram(m_program.get());
+	glGetProgramiv(m_program.get(), GL_LINK_STATUS, &status);
 	m_linked = (status == GL_TRUE);
-	glGetProgramInfoLog(m_program_id, 512, NULL, buffer);
+	glGetProgramInfoLog(m_program.get(), 512, NULL, buffer);
 	m_error_log.assign(buffer);
-}
 
-void ShaderProgram::free()
-{
-	glDeleteProgram(m_program_id);
+	// Uniforms only get their locations when linking, so this is the only time they are asked for
+	m_uniform_locations.clear();
+	if (m_linked)
+	{
+		GLint num_uniforms, max_length;
+		glGetProgramiv(m_program.get(), GL_ACTIVE_UNIFORMS, &num_uniforms);
+		glGetProgramiv(m_program.get(), GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+		std::vector<char> name(max_length);
+		for (GLint i = 0; i < num_uniforms; ++i)
+		{
+			GLsizei length;
+			GLint size;
+			GLenum type;
+			glGetActiveUniform(m_program.get(), i, max_length, &length, &size, &type, name.data());
+			GLint location = glGetUniformLocation(m_program.get(), name.data());
+
+			// Arrays are listed as their first element
+			std::string uniform_name(name.data(), length);
+			uniform_name = uniform_name.substr(0, uniform_name.find('['));
+			m_uniform_locations[uniform_name] = location;
+		}
+	}
+#endif
 }
 
 void ShaderProgram::use()
 {
-	glUseProgram(m_program_id);
+#ifndef HEADLESS
+	glUseProgram(m_program.get());
+#endif
 }
 
 bool ShaderProgram::isLinked() const
@@ -59,35 +107,84 @@ const std::string &ShaderProgram::log() const
 	return m_error_log;
 }
 
-void ShaderProgram::setUniform2f(std::string const& uniform_name, float v0, float v1)
+UniformHandle ShaderProgram::getUniform(std::string const& uniform_name)
 {
-	GLint location = glGetUniformLocation(m_program_id, uniform_name.c_str());
+	++m_uniform_stats.lookups;
+
+	UniformHandle uniform;
+	auto it = m_uniform_locations.find(uniform_name);
+	if (it != m_uniform_locations.end())
+		uniform.location = it->second;
 
-	if(location != -1)
-		glUniform2f(location, v0, v1);
+	return uniform;
 }
 
-void ShaderProgram::setUniform3f(std::string const& uniform_name, float v0, float v1, float v2)
+void ShaderProgram::setUniform1f(UniformHandle uniform, float v0)
 {
-	GLint location = glGetUniformLocation(m_program_id, uniform_name.c_str());
+	++m_uniform_stats.sets;
+#ifndef HEADLESS
+	if (uniform.isValid())
+		glUniform1f(uniform.location, v0);
+#endif
+}
 
-	if(location != -1)
-		glUniform3f(location, v0, v1, v2);
+void ShaderProgram::setUniform2f(UniformHandle uniform, float v0, float v1)
+{
+	++m_uniform_stats.sets;
+#ifndef HEADLESS
+	if (uniform.isValid())
+		glUniform2f(uniform.location, v0, v1);
+#endif
 }
 
-void ShaderProgram::setUniform4f(std::string const& uniform_name, float v0, float v1, float v2, float v3)
+void ShaderProgram::setUniform3f(UniformHandle uniform, float v0, float v1, float v2)
+{
+	++m_uniform_stats.sets;
+#ifndef HEADLESS
+	if (uniform.isValid())
+		glUniform3f(uniform.location, v0, v1, v2);
+#endif
+}
+
+void ShaderProgram::setUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3)
+{
+	++m_uniform_stats.sets;
+#ifndef HEADLESS
+	if (uniform.isValid())
+		glUniform4f(uniform.location, v0, v1, v2, v3);
+#endif
+}
+
+void ShaderProgram::setUniformMatrix4f(UniformHandle uniform, glm::mat4 const& mat)
 {
-	GLint location = glGetUniformLocation(m_program_id, uniform_name.c_str());
+	++m_uniform_stats.sets;
+#ifndef HEADLESS
+	if (uniform.isValid())
+		glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(mat));
+#endif
+}
+
+void ShaderProgram::setUniform1f(std::string const& uniform_name, float v0)
+{
+	setUniform1f(getUniform(uniform_name), v0);
+}
 
-	if(location != -1)
-		glUniform4f(location, v0, v1, v2, v3);
+void ShaderProgram::setUniform2f(std::string const& uniform_name, float v0, float v1)
+{
+	setUniform2f(getUniform(uniform_name), v0, v1);
 }
 
-void ShaderProgram::setUniformMatrix4f(std::string const& uniform_name, glm::mat4 &mat)
+void ShaderProgram::setUniform3f(std::string const& uniform_name, float v0, float v1, float v2)
 {
-	GLint location = glGetUniformLocation(m_program_id, uniform_name.c_str());
+	setUniform3f(getUniform(uniform_name), v0, v1, v2);
+}
 
-	if(location != -1)
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+void ShaderProgram::setUniform4f(std::string const& uniform_name, float v0, float v1, float v2, float v3)
+{
+	setUniform4f(getUniform(uniform_name), v0, v1, v2, v3);
 }
 
+void ShaderProgram::setUniformMatrix4f(std::string const& uniform_name, glm::mat4 const& mat)
+{
+	setUniformMatrix4f(getUniform(uniform_name), mat);
+}
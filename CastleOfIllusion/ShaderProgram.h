@@ -5,9 +5,31 @@
 #include <GL/glew.h>
 #include <GL/gl.h>
 #include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
 #include "Shader.h"
 
 
+// A uniform of a linked program, looked up once so that setting it doesn't have to ask the driver where it is
+struct UniformHandle
+{
+	// The location in the program, -1 if the program doesn't use the uniform
+	GLint location = -1;
+
+	bool isValid() const { return location != -1; }
+};
+
+// Counters of how the uniforms of a program have been set
+struct UniformStats
+{
+	// Uniform values sent to the driver
+	std::size_t sets = 0;
+
+	// Uniforms found by name, in the cache filled at link time
+	std::size_t lookups = 0;
+};
+
+
 // Using the Shader class ShaderProgram can link a vertex and a fragment shader
 // together, bind input attributes to their corresponding vertex shader names, 
 // and bind the fragment output to a name from the fragment shader
@@ -19,8 +41,6 @@ class ShaderProgram
 public:
 	ShaderProgram() = default;
 
-	~ShaderProgram() { free(); }
-
 	// Initializes the shader program
 	void init();
 
@@ -29,31 +49,52 @@ public:
 
 	void bindFragmentOutput(std::string const& output_name) const;
 	GLint bindVertexAttribute(std::string const& attrib_name, GLint size, GLsizei stride, GLvoid* first_pointer) const;
+
+	// Binds an attribute of the given type that advances once per instance instead of once per vertex. Integer types
+	// reach the shader as integers
+	GLint bindInstanceAttribute(std::string const& attrib_name, GLint size, GLenum type, GLsizei stride, GLvoid* first_pointer) const;
 	void link();
 
 	void use();
 
+	// Returns the handle of a uniform, which is valid until the program is linked again
+	UniformHandle getUniform(std::string const& uniform_name);
+
 	// Pass uniforms to the associated shaders
+	void setUniform1f(UniformHandle uniform, float v0);
+	void setUniform2f(UniformHandle uniform, float v0, float v1);
+	void setUniform3f(UniformHandle uniform, float v0, float v1, float v2);
+	void setUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3);
+	void setUniformMatrix4f(UniformHandle uniform, glm::mat4 const& mat);
+
+	// Same as above, looking the uniform up by name first
+	void setUniform1f(std::string const& uniform_name, float v0);
 	void setUniform2f(std::string const& uniform_name, float v0, float v1);
 	void setUniform3f(std::string const& uniform_name, float v0, float v1, float v2);
 	void setUniform4f(std::string const& uniform_name, float v0, float v1, float v2, float v3);
-	void setUniformMatrix4f(std::string const& uniform_name, glm::mat4& mat);
+	void setUniformMatrix4f(std::string const& uniform_name, glm::mat4 const& mat);
+
+	// Returns the counters since the program was created. Without a GPU (HEADLESS) uniforms are counted as if
+	// they were sent
+	UniformStats const& getUniformStats() const { return m_uniform_stats; }
 
 	bool isLinked() const;
 	std::string const& log() const;
 
 private:
-	// Cleans up resources
-	void free();
-
-	// The ID of this shader program
-	GLuint m_program_id = 0;
+	// The OpenGL object of this shader program, deleted with it
+	GLProgram m_program;
 
 	// True iff the program is linked (and successfully)
 	bool m_linked = false;
 
 	// The error log string, if any
 	std::string m_error_log;
+
+	// The location of every active uniform, by name, filled when the program is linked
+	std::unordered_map<std::string, GLint> m_uniform_locations;
+
+	UniformStats m_uniform_stats;
 };
 
 
@@ -0,0 +1,66 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+void SpatialHash::findPairs(std::vector<std::shared_ptr<Entity>> const& entities, std::vector<std::pair<std::size_t, std::size_t>>& pairs)
+{
+	m_entries.clear();
+	pairs.clear();
+
+	// Insert every entity in each of the cells its collision box touches
+	for (std::size_t i = 0; i < entities.size(); ++i)
+	{
+		if (!entities[i]->canCollide())
+			continue;
+
+		auto [min, max] = entities[i]->getMinMaxCollisionCoords();
+
+		int const min_x = cellOf(min.x);
+		int const max_x = cellOf(max.x);
+		int const min_y = cellOf(min.y);
+		int const max_y = cellOf(max.y);
+
+		for (int y = min_y; y <= max_y; ++y)
+		{
+			for (int x = min_x; x <= max_x; ++x)
+				m_entries.emplace_back(key(x, y), i);
+		}
+	}
+
+	// Group the entries by cell, with the entities of each cell in index order
+	std::sort(m_entries.begin(), m_entries.end());
+
+	for (std::size_t first = 0; first < m_entries.size();)
+	{
+		std::size_t last = first + 1;
+		while (last < m_entries.size() && m_entries[last].first == m_entries[first].first)
+			++last;
+
+		for (std::size_t a = first; a < last; ++a)
+		{
+			for (std::size_t b = a + 1; b < last; ++b)
+				pairs.emplace_back(m_entries[a].second, m_entries[b].second);
+		}
+
+		first = last;
+	}
+
+	// Entities sharing more than one cell appear more than once
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
+
+int SpatialHash::cellOf(int coordinate) const
+{
+	// Round towards minus infinity so that negative coordinates do not share cell 0
+	int cell = coordinate / m_cell_size;
+	if (coordinate < 0 && cell * m_cell_size != coordinate)
+		--cell;
+
+	return cell;
+}
+
+uint64_t SpatialHash::key(int x, int y)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(y)) << 32) | static_cast<uint32_t>(x);
+}
@@ -0,0 +1,40 @@
+#ifndef _SPATIAL_HASH_INCLUDE
+#define _SPATIAL_HASH_INCLUDE
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "Entity.h"
+
+// Broadphase for the collisions between entities. Splits the level in a uniform grid of square cells and
+// only reports the pairs of entities whose collision boxes share at least one cell, so that entities that are
+// far away from each other are never tested. The grid is rebuilt every frame.
+class SpatialHash
+{
+public:
+	SpatialHash() = default;
+
+	// Sets the size of the cells in pixels, which should be close to the size of most entities (ie. a tile)
+	void setCellSize(int cell_size) { m_cell_size = cell_size; }
+
+	// Rebuilds the grid with all the entities that can collide and fills pairs with the indices (i < j) of
+	// each pair that shares a cell. Pairs are unique and sorted, so they come in the same order as in a
+	// nested loop over the entities
+	void findPairs(std::vector<std::shared_ptr<Entity>> const& entities, std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+
+private:
+	// Returns the cell that contains the given coordinate (in pixels)
+	int cellOf(int coordinate) const;
+
+	// Packs the coordinates of a cell into a single key
+	static uint64_t key(int x, int y);
+
+	// The size of each cell, in pixels
+	int m_cell_size = 64;
+
+	// A (cell key, entity index) entry for every cell touched by every entity
+	// Kept between frames so that it does not allocate every frame
+	std::vector<std::pair<uint64_t, std::size_t>> m_entries;
+};
+
+#endif // _SPATIAL_HASH_INCLUDE
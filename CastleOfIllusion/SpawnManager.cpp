@@ -0,0 +1,94 @@
+#include "SpawnManager.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SpawnManager::clear()
+{
+	m_spawns.clear();
+	m_by_min.clear();
+	m_by_max.clear();
+	m_started = 0;
+	m_ended = 0;
+	m_in_range.clear();
+	m_active.clear();
+}
+
+void SpawnManager::add(std::shared_ptr<Enemy> enemy)
+{
+	Spawn spawn;
+	std::tie(spawn.min_x, spawn.max_x) = enemy->getSpawnXRange();
+	spawn.enemy = std::move(enemy);
+	m_spawns.push_back(std::move(spawn));
+}
+
+void SpawnManager::build()
+{
+	m_by_min.resize(m_spawns.size());
+	std::iota(m_by_min.begin(), m_by_min.end(), 0);
+	std::stable_sort(m_by_min.begin(), m_by_min.end(), [this](std::size_t first, std::size_t second)
+		{
+			return m_spawns[first].min_x < m_spawns[second].min_x;
+		});
+
+	m_by_max.resize(m_spawns.size());
+	std::iota(m_by_max.begin(), m_by_max.end(), 0);
+	std::stable_sort(m_by_max.begin(), m_by_max.end(), [this](std::size_t first, std::size_t second)
+		{
+			return m_spawns[first].max_x < m_spawns[second].max_x;
+		});
+}
+
+void SpawnManager::moveCursors(int camera_min_x, int camera_max_x)
+{
+	// The right side of the camera moved right or left
+	while (m_started < m_by_min.size() && m_spawns[m_by_min[m_started]].min_x <= camera_max_x)
+	{
+		m_spawns[m_by_min[m_started]].started = true;
+		updateRange(m_by_min[m_started]);
+		++m_started;
+	}
+	while (m_started > 0 && m_spawns[m_by_min[m_started - 1]].min_x > camera_max_x)
+	{
+		--m_started;
+		m_spawns[m_by_min[m_started]].started = false;
+		updateRange(m_by_min[m_started]);
+	}
+
+	// The left side of the camera moved right or left
+	while (m_ended < m_by_max.size() && m_spawns[m_by_max[m_ended]].max_x < camera_min_x)
+	{
+		m_spawns[m_by_max[m_ended]].ended = true;
+		updateRange(m_by_max[m_ended]);
+		++m_ended;
+	}
+	while (m_ended > 0 && m_spawns[m_by_max[m_ended - 1]].max_x >= camera_min_x)
+	{
+		--m_ended;
+		m_spawns[m_by_max[m_ended]].ended = false;
+		updateRange(m_by_max[m_ended]);
+	}
+}
+
+void SpawnManager::updateRange(std::size_t index)
+{
+	Spawn& spawn = m_spawns[index];
+	bool in_range = spawn.started && !spawn.ended;
+
+	if (in_range && spawn.range_slot == S_NONE)
+	{
+		spawn.range_slot = m_in_range.size();
+		m_in_range.push_back(index);
+	}
+	else if (!in_range && spawn.range_slot != S_NONE)
+	{
+		// The camera can't see it anymore
+		spawn.in_view = false;
+
+		std::size_t last = m_in_range.back();
+		m_in_range[spawn.range_slot] = last;
+		m_spawns[last].range_slot = spawn.range_slot;
+		m_in_range.pop_back();
+		spawn.range_slot = S_NONE;
+	}
+}
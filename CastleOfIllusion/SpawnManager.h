@@ -0,0 +1,125 @@
+#ifndef _SPAWN_MANAGER_INCLUDE
+#define _SPAWN_MANAGER_INCLUDE
+
+#include <vector>
+#include <memory>
+#include "Enemy.h"
+#include "Camera.h"
+
+// Decides when enemies appear and disappear. An enemy appears when its spawn point comes into view and
+// disappears when the camera stops seeing it; it appears again only after its spawn point has left the view.
+// Spawn points are kept sorted by the left and the right side of their boxes, so as the camera moves only the
+// ones whose side it crosses are looked at. Enemies that are not active are out of the scene's lists entirely.
+class SpawnManager
+{
+public:
+	SpawnManager() = default;
+
+	// Removes all spawn points
+	void clear();
+
+	// Adds the spawn point of an enemy, which starts inactive. build() has to be called after adding all of them
+	void add(std::shared_ptr<Enemy> enemy);
+
+	// Sorts the spawn points, so that the camera can be followed
+	void build();
+
+	// Retires the active enemies the camera does not see anymore, calling on_retire(enemy) for each of them, and
+	// activates those whose spawn point has just come into view, calling on_activate(enemy)
+	template <typename Activate, typename Retire>
+	void update(Camera const& camera, Activate&& on_activate, Retire&& on_retire);
+
+private:
+	struct Spawn
+	{
+		std::shared_ptr<Enemy> enemy;
+
+		// The horizontal extent of the enemy's collision box at the spawn point
+		int min_x;
+		int max_x;
+
+		// True iff the left side is not after the camera's right side, ie. it is before the cursor in m_by_min
+		bool started = false;
+
+		// True iff the right side is before the camera's left side, ie. it is before the cursor in m_by_max
+		bool ended = false;
+
+		// The position in m_in_range, if the camera's x range overlaps the spawn point
+		std::size_t range_slot = S_NONE;
+
+		// True iff the camera saw the spawn point in the last update
+		bool in_view = false;
+
+		// True iff the enemy is in the scene
+		bool active = false;
+	};
+
+	// Adds or removes a spawn point from m_in_range after one of its sides has been crossed
+	void updateRange(std::size_t index);
+
+	// Moves the cursors to the camera's x range, calling updateRange for each spawn point they cross
+	void moveCursors(int camera_min_x, int camera_max_x);
+
+	static constexpr std::size_t S_NONE = static_cast<std::size_t>(-1);
+
+	// All spawn points, in the order they were added
+	std::vector<Spawn> m_spawns;
+
+	// The spawn points sorted by min_x, and how many of them have started
+	std::vector<std::size_t> m_by_min;
+	std::size_t m_started = 0;
+
+	// The spawn points sorted by max_x, and how many of them have ended
+	std::vector<std::size_t> m_by_max;
+	std::size_t m_ended = 0;
+
+	// The spawn points that have started and not ended, which are the only ones the camera may see
+	std::vector<std::size_t> m_in_range;
+
+	// The spawn points whose enemy is active
+	std::vector<std::size_t> m_active;
+};
+
+template <typename Activate, typename Retire>
+void SpawnManager::update(Camera const& camera, Activate&& on_activate, Retire&& on_retire)
+{
+	// Same rounding as Camera::isVisible
+	glm::ivec2 camera_min = camera.getPosition();
+	glm::ivec2 camera_max = camera.getPosition() + camera.getSize();
+	moveCursors(camera_min.x, camera_max.x);
+
+	for (std::size_t i = 0; i < m_active.size();)
+	{
+		Spawn& spawn = m_spawns[m_active[i]];
+		if (spawn.enemy->isVisible())
+		{
+			++i;
+			continue;
+		}
+
+		spawn.active = false;
+		spawn.enemy->disable();
+		on_retire(spawn.enemy);
+
+		m_active[i] = m_active.back();
+		m_active.pop_back();
+	}
+
+	for (std::size_t index : m_in_range)
+	{
+		Spawn& spawn = m_spawns[index];
+		bool in_view = spawn.enemy->isSpawnPointVisible();
+
+		if (in_view && !spawn.in_view && !spawn.active)
+		{
+			spawn.active = true;
+			spawn.enemy->enable();
+			on_activate(spawn.enemy);
+			m_active.push_back(index);
+		}
+
+		spawn.in_view = in_view;
+	}
+}
+
+#endif // _SPAWN_MANAGER_INCLUDE
@@ -1,6 +1,4 @@
-#include <GL/glew.h>
-#include <GL/gl.h>
-#include <glm/gtc/matrix_transform.hpp>
+#include <utility>
 #include "Sprite.h"
 
 
@@ -15,20 +13,6 @@ Sprite *Sprite::createSprite(glm::ivec2 quad_size, glm::vec2 size_in_spritesheet
 Sprite::Sprite(glm::ivec2 quad_size, glm::vec2 size_in_spritesheet, std::shared_ptr<Texture> spritesheet, 
 	           std::shared_ptr<ShaderProgram> program)
 {
-	float vertices[24] = {0.f, 0.f, 0.f, 0.f, 
-						  quad_size.x, 0.f, size_in_spritesheet.x, 0.f, 
-						  quad_size.x, quad_size.y, size_in_spritesheet.x, size_in_spritesheet.y, 
-						  0.f, 0.f, 0.f, 0.f, 
-						  quad_size.x, quad_size.y, size_in_spritesheet.x, size_in_spritesheet.y, 
-						  0.f, quad_size.y, 0.f, size_in_spritesheet.y};
-
-	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
-	glGenBuffers(1, &m_vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), vertices, GL_STATIC_DRAW);
-	m_pos_location = program->bindVertexAttribute("position", 2, 4*sizeof(float), 0);
-	m_texcoord_location = program->bindVertexAttribute("texCoord", 2, 4*sizeof(float), (void *)(2*sizeof(float)));
 	m_texture = spritesheet;
 	m_shader_program = program;
 	m_current_keyframe = 0;
@@ -37,6 +21,10 @@ Sprite::Sprite(glm::ivec2 quad_size, glm::vec2 size_in_spritesheet, std::shared_
 	m_position = glm::vec2(0.f);
 	m_quad_size = quad_size;
 	m_size_in_spritesheet = size_in_spritesheet;
+
+	// The spritesheet may be a region of an atlas
+	m_size_in_image = spritesheet->toImageSize(size_in_spritesheet);
+	m_texcoord_displ = spritesheet->toImageCoords(glm::vec2(0.f));
 }
 
 void Sprite::update(int delta_time)
@@ -55,26 +43,17 @@ void Sprite::update(int delta_time)
 		m_flicker_counter++;
 }
 
-void Sprite::render() const
+void Sprite::render(SpriteBatch& batch) const
 {
 	if (!m_flicker || (m_flicker_counter % 4) < 2) // flicker 2 consecutive frames every 4 frames
 	{
-		glm::mat4 modelview = glm::translate(glm::mat4(1.0f), glm::vec3(m_position.x, m_position.y, 0.f));
-		m_shader_program->setUniformMatrix4f("modelview", modelview);
-		m_shader_program->setUniform2f("texCoordDispl", m_texcoord_displ.x, m_texcoord_displ.y);
-		glEnable(GL_TEXTURE_2D);
-		m_texture->use();
-		glBindVertexArray(m_vao);
-		glEnableVertexAttribArray(m_pos_location);
-		glEnableVertexAttribArray(m_texcoord_location);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		glDisable(GL_TEXTURE_2D);
-	}
-}
+		glm::vec2 texcoord_min = m_texcoord_displ;
+		glm::vec2 texcoord_max = m_texcoord_displ + m_size_in_image;
+		if (m_looking_left)
+			std::swap(texcoord_min.x, texcoord_max.x);
 
-void Sprite::free()
-{
-	glDeleteBuffers(1, &m_vbo);
+		batch.draw(*m_texture, m_position, glm::vec2(m_quad_size), texcoord_min, texcoord_max);
+	}
 }
 
 void Sprite::setNumberAnimations(int num_animations)
@@ -91,13 +70,13 @@ void Sprite::setAnimationSpeed(int animation_id, int keyframes_per_sec)
 
 void Sprite::setTextureCoordsOffset(glm::vec2 offset) 
 {
-	m_texcoord_displ = offset;
+	m_texcoord_displ = m_texture->toImageCoords(offset);
 }
 
 void Sprite::addKeyframe(int animation_id, glm::vec2 displacement)
 {
 	if(animation_id < static_cast<int>(m_animations.size()))
-		m_animations[animation_id].keyframeDispl.push_back(displacement*m_size_in_spritesheet);
+		m_animations[animation_id].keyframeDispl.push_back(m_texture->toImageCoords(displacement*m_size_in_spritesheet));
 }
 
 void Sprite::changeAnimation(int animation_id)
@@ -128,27 +107,12 @@ glm::ivec2 Sprite::getQuadSize() const
 
 void Sprite::turnRight()
 {
-	float vertices[24] = { 0.f, 0.f, 0.f, 0.f,
-						  m_quad_size.x, 0.f, m_size_in_spritesheet.x, 0.f,
-						  m_quad_size.x, m_quad_size.y, m_size_in_spritesheet.x, m_size_in_spritesheet.y,
-						  0.f, 0.f, 0.f, 0.f,
-						  m_quad_size.x, m_quad_size.y, m_size_in_spritesheet.x, m_size_in_spritesheet.y,
-						  0.f, m_quad_size.y, 0.f, m_size_in_spritesheet.y };
-
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), vertices, GL_STATIC_DRAW);
+	m_looking_left = false;
 }
+
 void Sprite::turnLeft()
 {
-	float vertices[24] = { 0.f, 0.f, m_size_in_spritesheet.x, 0.f,
-						  m_quad_size.x, 0.f, 0.f, 0.f,
-						  m_quad_size.x, m_quad_size.y, 0.f, m_size_in_spritesheet.y,
-						  0.f, 0.f, m_size_in_spritesheet.x, 0.f,
-						  m_quad_size.x, m_quad_size.y, 0.f, m_size_in_spritesheet.y,
-						  0.f, m_quad_size.y, m_size_in_spritesheet.x, m_size_in_spritesheet.y };
-
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), vertices, GL_STATIC_DRAW);
+	m_looking_left = true;
 }
 
 void Sprite::startFlickering()
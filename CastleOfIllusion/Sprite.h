@@ -7,6 +7,7 @@
 #include "Texture.h"
 #include "ShaderProgram.h"
 #include "AnimKeyframes.h"
+#include "SpriteBatch.h"
 
 // This class is derived from code seen earlier in TexturedQuad but it is also
 // able to manage animations stored as a spritesheet. 
@@ -14,18 +15,16 @@ class Sprite
 {
 
 public:
-	// Textured quads can only be created inside an OpenGL context
+	// Sprites own no GPU resources, they are drawn as instances of the unit quad of a SpriteBatch
 	// Assumes the sprite is looking to the right
 	static Sprite* createSprite(glm::ivec2 quad_size, glm::vec2 size_in_spritesheet,
 		                        std::shared_ptr<Texture> spritesheet, std::shared_ptr<ShaderProgram> program);
 
-	~Sprite() { free(); }
-
 	// Updates the sprite
 	void update(int delta_time);
 
-	// Renders the sprite
-	void render() const;
+	// Adds the sprite to a batch, which draws it along with the other sprites that use the same texture
+	void render(SpriteBatch& batch) const;
 
 	// Sets the number of animations of the sprite
 	void setNumberAnimations(int num_animations);
@@ -53,7 +52,7 @@ public:
 	// Returns the shader program
 	std::shared_ptr<ShaderProgram> getShaderProgram() const { return m_shader_program; }
 
-	// Flips the sprite so that it looks to the right (default)
+	// Flips the sprite so that it looks to the right (default). Flipping is done when rendering, it costs nothing
 	void turnRight();
 
 	// Flips the sprite so that it looks to the left
@@ -70,27 +69,12 @@ private:
 	Sprite(glm::ivec2 quad_size, glm::vec2 size_in_spritesheet, std::shared_ptr<Texture> spritesheet, 
 		   std::shared_ptr<ShaderProgram> program);
 
-	// Cleans up resources
-	void free();
-
 	// The texture used for the sprite
 	std::shared_ptr<Texture> m_texture;
 
 	// The shader program used to render this sprite
 	std::shared_ptr<ShaderProgram> m_shader_program;
 
-	// The VAO for this object
-	GLuint m_vao;
-
-	// The VBO for this object
-	GLuint m_vbo;
-
-	// The location of the position in the shader
-	GLint m_pos_location; 
-
-	// The location of the texture coords in the shader
-	GLint m_texcoord_location;
-
 	// The position of the sprite
 	glm::vec2 m_position;
 
@@ -107,15 +91,21 @@ private:
 	float m_time_animation;
 
 	// The texture coordinates offset, ie. the position of the top left corner of the miniquad
-	// inside the texture
+	// inside the texture's image, which is an atlas if the texture is a region of one
 	glm::vec2 m_texcoord_displ;
 
 	// The size of a single sprite in the spritesheet
 	glm::vec2 m_size_in_spritesheet;
 
+	// The size of a single sprite in the texture's image
+	glm::vec2 m_size_in_image;
+
 	// The different animations the sprite may have
 	std::vector<AnimKeyframes> m_animations;
 
+	// True iff the sprite has been flipped to look to the left, which swaps the x of its texture coordinates
+	bool m_looking_left = false;
+
 	// True iff the sprite should currently be flickering
 	bool m_flicker = false;
 
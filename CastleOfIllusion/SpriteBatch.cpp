@@ -0,0 +1,104 @@
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <cstring>
+#include "SpriteBatch.h"
+
+// Floats per instance: position and size of the quad, and texture coords of its top left and bottom right corners
+#define INSTANCE_SIZE 8
+
+void SpriteBatch::init(std::shared_ptr<ShaderProgram> program)
+{
+	m_shader_program = program;
+	m_capacity = 0;
+
+#ifndef HEADLESS
+	// The two triangles of the unit quad, from its top left corner (0,0) to its bottom right one (1,1)
+	float corners[12] = { 0.f, 0.f, 1.f, 0.f, 1.f, 1.f,
+						  0.f, 0.f, 1.f, 1.f, 0.f, 1.f };
+
+	m_vao = GLVertexArray::generate();
+	glBindVertexArray(m_vao.get());
+
+	m_quad_vbo = GLBuffer::generate();
+	glBindBuffer(GL_ARRAY_BUFFER, m_quad_vbo.get());
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	m_corner_location = program->bindVertexAttribute("corner", 2, 2*sizeof(float), 0);
+
+	m_instance_vbo = GLBuffer::generate();
+	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo.get());
+	m_quad_rect_location = program->bindInstanceAttribute("quadRect", 4, GL_FLOAT, INSTANCE_SIZE*sizeof(float), 0);
+	m_tex_rect_location = program->bindInstanceAttribute("texRect", 4, GL_FLOAT, INSTANCE_SIZE*sizeof(float), (void *)(4*sizeof(float)));
+#endif
+}
+
+void SpriteBatch::free()
+{
+	m_instance_vbo.reset();
+	m_quad_vbo.reset();
+	m_vao.reset();
+	m_capacity = 0;
+}
+
+void SpriteBatch::begin()
+{
+	m_instances.clear();
+	m_texture = nullptr;
+	m_quads = 0;
+	m_draw_calls = 0;
+}
+
+void SpriteBatch::draw(Texture const& texture, glm::vec2 pos, glm::vec2 size, glm::vec2 texcoord_min, glm::vec2 texcoord_max)
+{
+	// Textures that are regions of the same atlas don't break the batch
+	if (m_texture != &texture.getImage())
+	{
+		flush();
+		m_texture = &texture.getImage();
+	}
+
+	float instance[INSTANCE_SIZE] = { pos.x, pos.y, size.x, size.y,
+									  texcoord_min.x, texcoord_min.y, texcoord_max.x, texcoord_max.y };
+
+	m_instances.insert(m_instances.end(), instance, instance + INSTANCE_SIZE);
+	++m_quads;
+}
+
+void SpriteBatch::end()
+{
+	flush();
+	m_texture = nullptr;
+}
+
+void SpriteBatch::flush()
+{
+	if (m_instances.empty())
+		return;
+
+#ifndef HEADLESS
+	glBindVertexArray(m_vao.get());
+	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo.get());
+
+	// Storage is only allocated when the batch grows. Otherwise invalidating the buffer lets the driver hand out
+	// fresh memory while the previous draw may still be reading the old one, instead of waiting for it
+	if (m_instances.size() > m_capacity)
+	{
+		m_capacity = m_instances.capacity();
+		glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(float), nullptr, GL_STREAM_DRAW);
+	}
+	void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, m_instances.size() * sizeof(float),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	std::memcpy(mapped, m_instances.data(), m_instances.size() * sizeof(float));
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+
+	glEnable(GL_TEXTURE_2D);
+	m_texture->use();
+	glEnableVertexAttribArray(m_corner_location);
+	glEnableVertexAttribArray(m_quad_rect_location);
+	glEnableVertexAttribArray(m_tex_rect_location);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(m_instances.size() / INSTANCE_SIZE));
+	glDisable(GL_TEXTURE_2D);
+#endif
+
+	++m_draw_calls;
+	m_instances.clear();
+}
@@ -0,0 +1,79 @@
+#ifndef _SPRITE_BATCH_INCLUDE
+#define _SPRITE_BATCH_INCLUDE
+
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "Texture.h"
+#include "ShaderProgram.h"
+#include "GLHandle.h"
+
+// Collects textured quads in the order they are drawn and sends them to the GPU in as few draw calls as possible.
+// Every quad is an instance of the same unit quad, described by its rectangle in the world and in the texture, and
+// the instances are written into one buffer that is refilled every frame. A draw call is only issued when the
+// texture changes, so drawing order (and therefore what ends up on top) is kept.
+// Unless built with HEADLESS defined nothing is sent to the GPU, but the quads and draw calls are still counted
+class SpriteBatch
+{
+public:
+	SpriteBatch() = default;
+
+	// The buffers belong to a single batch
+	SpriteBatch(SpriteBatch const&) = delete;
+	SpriteBatch& operator=(SpriteBatch const&) = delete;
+
+	// Creates the unit quad and the instance buffer, bound to the attributes of the program
+	void init(std::shared_ptr<ShaderProgram> program);
+
+	// Starts a new batch
+	void begin();
+
+	// Adds a quad whose top left corner is at pos, textured with the rectangle between texcoord_min and
+	// texcoord_max, which are coordinates in the texture's image (see Texture::toImageCoords). Swapping the x of
+	// both texture coordinates flips the quad horizontally
+	void draw(Texture const& texture, glm::vec2 pos, glm::vec2 size, glm::vec2 texcoord_min, glm::vec2 texcoord_max);
+
+	// Draws whatever is left in the batch. The program has to be in use
+	void end();
+
+	// Deletes the buffers, until init creates them again
+	void free();
+
+	// Returns the number of quads drawn since the last begin()
+	int getQuads() const { return m_quads; }
+
+	// Returns the number of draw calls issued since the last begin()
+	int getDrawCalls() const { return m_draw_calls; }
+
+private:
+	// Draws the collected quads, all of which use m_texture
+	void flush();
+
+	// The shader program the instances are laid out for
+	std::shared_ptr<ShaderProgram> m_shader_program;
+
+	// The VAO, the VBO with the unit quad and the streaming VBO with the instances
+	GLVertexArray m_vao;
+	GLBuffer m_quad_vbo;
+	GLBuffer m_instance_vbo;
+
+	// The locations of the corner of the unit quad and of the rectangles of each instance in the shader
+	GLint m_corner_location = -1;
+	GLint m_quad_rect_location = -1;
+	GLint m_tex_rect_location = -1;
+
+	// The size of the instance VBO, in floats, which only grows
+	std::size_t m_capacity = 0;
+
+	// The instances waiting to be drawn: position and size of the quad, and its texture rectangle
+	std::vector<float> m_instances;
+
+	// The image the instances waiting to be drawn are textured with
+	Texture const* m_texture = nullptr;
+
+	// Counters for the current batch
+	int m_quads = 0;
+	int m_draw_calls = 0;
+};
+
+#endif // _SPRITE_BATCH_INCLUDE
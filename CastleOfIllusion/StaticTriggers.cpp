@@ -0,0 +1,40 @@
+#include "StaticTriggers.h"
+
+#include <algorithm>
+#include <climits>
+
+void StaticTriggers::clear()
+{
+	m_triggers.clear();
+}
+
+void StaticTriggers::add(std::shared_ptr<Entity> trigger)
+{
+	auto [min, max] = trigger->getMinMaxCollisionCoords();
+	m_triggers.push_back({ min, max, max.x, trigger });
+}
+
+void StaticTriggers::build()
+{
+	std::stable_sort(m_triggers.begin(), m_triggers.end(), [](Trigger const& first, Trigger const& second)
+		{
+			return first.min.x < second.min.x;
+		});
+
+	int reach_x = INT_MIN;
+	for (auto& trigger : m_triggers)
+	{
+		reach_x = std::max(reach_x, trigger.max.x);
+		trigger.reach_x = reach_x;
+	}
+}
+
+std::size_t StaticTriggers::firstReaching(int x) const
+{
+	auto it = std::lower_bound(m_triggers.begin(), m_triggers.end(), x, [](Trigger const& trigger, int x)
+		{
+			return trigger.reach_x < x;
+		});
+
+	return static_cast<std::size_t>(it - m_triggers.begin());
+}
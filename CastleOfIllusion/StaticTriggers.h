@@ -0,0 +1,66 @@
+#ifndef _STATIC_TRIGGERS_INCLUDE
+#define _STATIC_TRIGGERS_INCLUDE
+
+#include <vector>
+#include <memory>
+#include "Entity.h"
+
+// Holds the trigger volumes that never move (voids and camera points) out of the per-frame pair loop.
+// They are kept as a list of intervals sorted by the left side of their boxes, built once when the level is
+// read, and dynamic entities ask for the triggers they overlap only when they have moved.
+class StaticTriggers
+{
+public:
+	StaticTriggers() = default;
+
+	// Removes all triggers
+	void clear();
+
+	// Returns whether there are no triggers
+	bool empty() const { return m_triggers.empty(); }
+
+	// Adds a trigger. build() has to be called after adding all of them
+	void add(std::shared_ptr<Entity> trigger);
+
+	// Sorts the triggers so that they can be queried
+	void build();
+
+	// Calls on_overlap(trigger) for each trigger whose collision box overlaps the box from min to max, in order
+	// of their left side. Whether the trigger can collide is left to the caller
+	template <typename Callable>
+	void query(glm::ivec2 const& min, glm::ivec2 const& max, Callable&& on_overlap) const;
+
+private:
+	struct Trigger
+	{
+		// The collision box
+		glm::ivec2 min;
+		glm::ivec2 max;
+
+		// The largest max.x of this trigger and all the previous ones, which grows along the list,
+		// so that the first trigger that could reach a given x can be binary searched
+		int reach_x;
+
+		std::shared_ptr<Entity> entity;
+	};
+
+	// Returns the index of the first trigger that may reach x
+	std::size_t firstReaching(int x) const;
+
+	// The triggers, sorted by min.x
+	std::vector<Trigger> m_triggers;
+};
+
+template <typename Callable>
+void StaticTriggers::query(glm::ivec2 const& min, glm::ivec2 const& max, Callable&& on_overlap) const
+{
+	for (std::size_t i = firstReaching(min.x); i < m_triggers.size() && m_triggers[i].min.x <= max.x; ++i)
+	{
+		Trigger const& trigger = m_triggers[i];
+
+		if (trigger.max.x >= min.x && trigger.max.y >= min.y && trigger.min.y <= max.y)
+			on_overlap(*trigger.entity);
+	}
+}
+
+#endif // _STATIC_TRIGGERS_INCLUDE
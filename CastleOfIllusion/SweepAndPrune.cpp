@@ -0,0 +1,69 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SweepAndPrune::findPairs(std::vector<std::shared_ptr<Entity>> const& entities, std::vector<std::pair<std::size_t, std::size_t>>& pairs)
+{
+	pairs.clear();
+
+	// The entities changed (ie. a new level was loaded), the previous order means nothing
+	if (m_order.size() != entities.size())
+	{
+		m_order.resize(entities.size());
+		std::iota(m_order.begin(), m_order.end(), 0);
+	}
+
+	m_boxes.resize(entities.size());
+	m_can_collide.resize(entities.size());
+	for (std::size_t i = 0; i < entities.size(); ++i)
+	{
+		m_boxes[i] = entities[i]->getMinMaxCollisionCoords();
+		m_can_collide[i] = entities[i]->canCollide();
+	}
+
+	insertionSort();
+
+	// Sweep: each box only has to be tested against the following ones until one starts after it ends
+	for (std::size_t a = 0; a < m_order.size(); ++a)
+	{
+		std::size_t const i = m_order[a];
+		if (!m_can_collide[i])
+			continue;
+
+		auto const& [min, max] = m_boxes[i];
+
+		for (std::size_t b = a + 1; b < m_order.size(); ++b)
+		{
+			std::size_t const j = m_order[b];
+			auto const& [other_min, other_max] = m_boxes[j];
+
+			if (other_min.x > max.x)
+				break;
+
+			if (!m_can_collide[j] || other_max.y < min.y || other_min.y > max.y)
+				continue;
+
+			pairs.emplace_back(std::min(i, j), std::max(i, j));
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end());
+}
+
+void SweepAndPrune::insertionSort()
+{
+	for (std::size_t a = 1; a < m_order.size(); ++a)
+	{
+		std::size_t const current = m_order[a];
+		int const current_x = m_boxes[current].first.x;
+
+		std::size_t b = a;
+		while (b > 0 && m_boxes[m_order[b - 1]].first.x > current_x)
+		{
+			m_order[b] = m_order[b - 1];
+			--b;
+		}
+		m_order[b] = current;
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef _SWEEP_AND_PRUNE_INCLUDE
+#define _SWEEP_AND_PRUNE_INCLUDE
+
+#include <vector>
+#include <memory>
+#include "Entity.h"
+
+// Broadphase for the collisions between entities. Keeps the entities sorted by the left side of their
+// collision boxes and sweeps along the X axis, so only entities that overlap horizontally are reported.
+// Levels are long horizontal strips and entities barely move between frames, so the order from the previous
+// frame is almost sorted and insertion sort fixes it in close to linear time.
+class SweepAndPrune
+{
+public:
+	SweepAndPrune() = default;
+
+	// Fills pairs with the indices (i < j) of each pair of entities that can collide and overlap on both axes.
+	// Pairs are unique and sorted, so they come in the same order as in a nested loop over the entities
+	void findPairs(std::vector<std::shared_ptr<Entity>> const& entities, std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+
+private:
+	// Sorts m_order by the left side of the boxes, starting from the order of the previous frame
+	void insertionSort();
+
+	// The indices of the entities, sorted by the left side of their collision box
+	std::vector<std::size_t> m_order;
+
+	// The (min, max) coordinates of the collision box of each entity this frame
+	std::vector<std::pair<glm::ivec2, glm::ivec2>> m_boxes;
+
+	// True iff the entity with that index can collide this frame
+	std::vector<bool> m_can_collide;
+};
+
+#endif // _SWEEP_AND_PRUNE_INCLUDE
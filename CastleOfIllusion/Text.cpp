@@ -1,4 +1,5 @@
 #include "Text.h"
+#include "TextureCache.h"
 #include <cmath>
 
 Text::Text(glm::vec2 const& pos, glm::ivec2 const& char_size, std::shared_ptr<ShaderProgram> shader_program)
@@ -7,8 +8,7 @@ Text::Text(glm::vec2 const& pos, glm::ivec2 const& char_size, std::shared_ptr<Sh
 	m_char_sprite_size = char_size;
 	m_shader_program = shader_program;
 
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile("images/Numbers.png", TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get("images/Numbers.png", TEXTURE_PIXEL_FORMAT_RGBA);
 
 	int num_digits = 6;
 	m_sprites.resize(num_digits);
@@ -41,10 +41,10 @@ void Text::setPosition(glm::vec2 pos)
 	}
 }
 
-void Text::render()
+void Text::render(SpriteBatch& batch)
 {
 	for (int i = 0; i < m_sprites.size(); ++i)
 	{
-		m_sprites[i]->render();
+		m_sprites[i]->render(batch);
 	}
 }
\ No newline at end of file
@@ -16,8 +16,8 @@ public:
     // Sets the position of the start of the text
     void setPosition(glm::vec2 pos);
 
-    // Renders the text
-    void render();
+    // Adds the text to the batch of sprites being rendered
+    void render(SpriteBatch& batch);
 
 private:
 
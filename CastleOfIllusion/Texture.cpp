@@ -1,4 +1,6 @@
+#ifndef HEADLESS
 #include <SOIL.h>
+#endif
 #include "Texture.h"
 
 using namespace std;
@@ -13,68 +15,107 @@ Texture::Texture()
 
 bool Texture::loadFromFile(std::string const& filename, PixelFormat format)
 {
+#ifdef HEADLESS
+	// Nothing is decoded or uploaded without a GPU, the simulation never samples textures
+	m_width = 0;
+	m_height = 0;
+	return true;
+#else
 	unsigned char *image = NULL;
+	int width, height;
 	
 	switch(format)
 	{
 	case TEXTURE_PIXEL_FORMAT_RGB:
-		image = SOIL_load_image(filename.c_str(), &m_width, &m_height, 0, SOIL_LOAD_RGB);
+		image = SOIL_load_image(filename.c_str(), &width, &height, 0, SOIL_LOAD_RGB);
 		break;
 	case TEXTURE_PIXEL_FORMAT_RGBA:
-		image = SOIL_load_image(filename.c_str(), &m_width, &m_height, 0, SOIL_LOAD_RGBA);
+		image = SOIL_load_image(filename.c_str(), &width, &height, 0, SOIL_LOAD_RGBA);
 		break;
 	}
 	if(image == NULL)
 		return false;
-	glGenTextures(1, &m_id);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+	loadFromPixels(image, width, height, format);
+	SOIL_free_image_data(image);
+	
+	return true;
+#endif
+}
+
+void Texture::loadFromPixels(unsigned char const* pixels, int width, int height, PixelFormat format)
+{
+	m_width = width;
+	m_height = height;
+#ifndef HEADLESS
+	m_id = GLTexture::generate();
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	switch(format)
 	{
 	case TEXTURE_PIXEL_FORMAT_RGB:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 		break;
 	case TEXTURE_PIXEL_FORMAT_RGBA:
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 		break;
 	}
 	glGenerateMipmap(GL_TEXTURE_2D);
-	
-	return true;
+#endif
+}
+
+void Texture::setRegion(std::shared_ptr<Texture> atlas, glm::ivec2 pos, glm::ivec2 size)
+{
+	glm::vec2 atlas_size(atlas->width(), atlas->height());
+
+	m_width = size.x;
+	m_height = size.y;
+	m_region_min = glm::vec2(pos) / atlas_size;
+	m_region_size = glm::vec2(size) / atlas_size;
+	m_atlas = std::move(atlas);
 }
 
 void Texture::loadFromGlyphBuffer(unsigned char *buffer, int width, int height)
 {
-	glGenTextures(1, &m_id);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+#ifndef HEADLESS
+	m_id = GLTexture::generate();
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, buffer);
 	glGenerateMipmap(GL_TEXTURE_2D);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+#endif
 }
 
 void Texture::createEmptyTexture(int width, int height)
 {
-	glGenTextures(1, &m_id);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+#ifndef HEADLESS
+	m_id = GLTexture::generate();
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+#endif
 }
 
 void Texture::loadSubtextureFromGlyphBuffer(unsigned char *buffer, int x, int y, int width, int height)
 {
-	glBindTexture(GL_TEXTURE_2D, m_id);
+#ifndef HEADLESS
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, buffer);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+#endif
 }
 
 void Texture::generateMipmap()
 {
-	glBindTexture(GL_TEXTURE_2D, m_id);
+#ifndef HEADLESS
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glGenerateMipmap(GL_TEXTURE_2D);
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+#endif
 }
 
 void Texture::setWrapS(GLint value)
@@ -99,10 +140,18 @@ void Texture::setMagFilter(GLint value)
 
 void Texture::use() const
 {
+	if (m_atlas)
+	{
+		m_atlas->use();
+		return;
+	}
+
+#ifndef HEADLESS
 	glEnable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+	glBindTexture(GL_TEXTURE_2D, m_id.get());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_wrap_s);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_wrap_t);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_minification_filter);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_magnification_filter);
+#endif
 }
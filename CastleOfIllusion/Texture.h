@@ -3,7 +3,10 @@
 
 
 #include <string>
+#include <memory>
 #include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "GLHandle.h"
 
 
 enum PixelFormat {TEXTURE_PIXEL_FORMAT_RGB, TEXTURE_PIXEL_FORMAT_RGBA};
@@ -20,6 +23,23 @@ public:
 	Texture();
 
 	bool loadFromFile(std::string const& filename, PixelFormat format);
+
+	// Uploads an image that is already decoded, with 3 or 4 bytes per pixel depending on the format.
+	// Without a GPU (HEADLESS) only the size is kept
+	void loadFromPixels(unsigned char const* pixels, int width, int height, PixelFormat format);
+
+	// Makes this texture a view of the rectangle of atlas with top left corner pos, so that using it binds the atlas.
+	// Texture coordinates of this texture have to go through toImageCoords before being sent to the GPU
+	void setRegion(std::shared_ptr<Texture> atlas, glm::ivec2 pos, glm::ivec2 size);
+
+	// Converts coordinates in this texture, from (0,0) to (1,1), into coordinates in the image that gets bound
+	glm::vec2 toImageCoords(glm::vec2 coords) const { return m_region_min + coords * m_region_size; }
+
+	// Converts a size in this texture into a size in the image that gets bound
+	glm::vec2 toImageSize(glm::vec2 size) const { return size * m_region_size; }
+
+	// Returns the texture that owns the image that gets bound when this one is used
+	Texture const& getImage() const { return m_atlas ? *m_atlas : *this; }
 	void loadFromGlyphBuffer(unsigned char *buffer, int width, int height);
 
 	void createEmptyTexture(int width, int height);
@@ -46,8 +66,8 @@ private:
 	// Has to be signed for library reasons
 	int m_height;
 	
-	// The texture's OpenGL ID
-	GLuint m_id;
+	// The texture's OpenGL object, deleted with the texture
+	GLTexture m_id;
 
 	// The wrap type
 	GLint m_wrap_s;
@@ -59,6 +79,13 @@ private:
 	// The magnification filter
 	GLint m_magnification_filter;
 
+	// The atlas this texture is a region of, if any
+	std::shared_ptr<Texture> m_atlas;
+
+	// The rectangle of the atlas this texture covers, in texture coordinates of the atlas
+	glm::vec2 m_region_min = glm::vec2(0.f);
+	glm::vec2 m_region_size = glm::vec2(1.f);
+
 };
 
 
@@ -0,0 +1,167 @@
+#ifndef HEADLESS
+#include <SOIL.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include "TextureAtlas.h"
+
+namespace
+{
+	// An image waiting to be copied into the atlas
+	struct AtlasImage
+	{
+		glm::ivec2 size;
+		unsigned char* pixels = nullptr;
+	};
+
+	// Returns the smallest power of two not smaller than value
+	int nextPowerOfTwo(int value)
+	{
+		int power = 1;
+		while (power < value)
+			power *= 2;
+		return power;
+	}
+
+#ifdef HEADLESS
+	// Nothing is decoded without a GPU, but the layout still needs the sizes, which are in the PNG header
+	AtlasImage loadImage(std::string const& path, PixelFormat)
+	{
+		std::ifstream file(path, std::ios::binary);
+		unsigned char header[24];
+		if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) || std::memcmp(header + 12, "IHDR", 4) != 0)
+			throw std::runtime_error("TextureAtlas::build: could not read " + path);
+
+		auto ReadInt = [&header](int offset)
+		{
+			return (header[offset] << 24) | (header[offset + 1] << 16) | (header[offset + 2] << 8) | header[offset + 3];
+		};
+
+		AtlasImage image;
+		image.size = glm::ivec2(ReadInt(16), ReadInt(20));
+		return image;
+	}
+#else
+	AtlasImage loadImage(std::string const& path, PixelFormat format)
+	{
+		AtlasImage image;
+		int channels = format == TEXTURE_PIXEL_FORMAT_RGBA ? SOIL_LOAD_RGBA : SOIL_LOAD_RGB;
+		image.pixels = SOIL_load_image(path.c_str(), &image.size.x, &image.size.y, 0, channels);
+		if (image.pixels == NULL)
+			throw std::runtime_error("TextureAtlas::build: could not read " + path);
+		return image;
+	}
+#endif
+}
+
+std::vector<std::shared_ptr<Texture>> TextureAtlas::build(std::vector<std::string> const& paths, PixelFormat format,
+	int max_size)
+{
+	std::vector<AtlasImage> images;
+	std::vector<glm::ivec2> sizes;
+	for (auto const& path : paths)
+	{
+		images.push_back(loadImage(path, format));
+		sizes.push_back(images.back().size);
+	}
+
+	std::vector<glm::ivec2> positions;
+	glm::ivec2 atlas_size = pack(sizes, S_PADDING, max_size, positions);
+	if (atlas_size.x == 0)
+		throw std::runtime_error("TextureAtlas::build: the images don't fit in a " + std::to_string(max_size) + " pixels atlas");
+
+	// Starts fully transparent, which is what the padding stays
+	std::vector<unsigned char> pixels;
+#ifndef HEADLESS
+	std::size_t channels = format == TEXTURE_PIXEL_FORMAT_RGBA ? 4 : 3;
+	pixels.resize(channels * atlas_size.x * atlas_size.y, 0);
+	for (std::size_t i = 0; i < images.size(); ++i)
+	{
+		std::size_t row_bytes = channels * images[i].size.x;
+		for (int y = 0; y < images[i].size.y; ++y)
+		{
+			std::size_t target = channels * ((positions[i].y + y) * atlas_size.x + positions[i].x);
+			std::memcpy(&pixels[target], images[i].pixels + y * row_bytes, row_bytes);
+		}
+		SOIL_free_image_data(images[i].pixels);
+	}
+#endif
+
+	auto atlas = std::make_shared<Texture>();
+	atlas->loadFromPixels(pixels.data(), atlas_size.x, atlas_size.y, format);
+
+	std::vector<std::shared_ptr<Texture>> regions;
+	for (std::size_t i = 0; i < images.size(); ++i)
+	{
+		regions.push_back(std::make_shared<Texture>());
+		regions.back()->setRegion(atlas, positions[i], sizes[i]);
+	}
+
+	return regions;
+}
+
+glm::ivec2 TextureAtlas::pack(std::vector<glm::ivec2> const& sizes, int padding, int max_size,
+	std::vector<glm::ivec2>& positions)
+{
+	// Tallest first, so that shelves waste little height
+	std::vector<std::size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t first, std::size_t second)
+		{
+			return sizes[first].y > sizes[second].y;
+		});
+
+	glm::ivec2 best_size(0, 0);
+	std::vector<glm::ivec2> candidate;
+	for (int width = 1; width <= max_size; width *= 2)
+	{
+		int height = packShelves(sizes, order, padding, width, candidate);
+		if (height < 0)
+			continue;
+
+		height = nextPowerOfTwo(std::max(height, 1));
+		if (height > max_size)
+			continue;
+
+		if (best_size.x == 0 || width * height < best_size.x * best_size.y)
+		{
+			best_size = glm::ivec2(width, height);
+			positions = candidate;
+		}
+	}
+
+	return best_size;
+}
+
+int TextureAtlas::packShelves(std::vector<glm::ivec2> const& sizes, std::vector<std::size_t> const& order, int padding,
+	int width, std::vector<glm::ivec2>& positions)
+{
+	positions.assign(sizes.size(), glm::ivec2(0, 0));
+
+	int shelf_y = 0;
+	int shelf_height = 0;
+	int x = 0;
+	for (std::size_t index : order)
+	{
+		glm::ivec2 size = sizes[index];
+		if (size.x > width)
+			return -1;
+
+		// Starts a new shelf below the current one
+		if (x > 0 && x + size.x > width)
+		{
+			shelf_y += shelf_height + padding;
+			shelf_height = 0;
+			x = 0;
+		}
+
+		positions[index] = glm::ivec2(x, shelf_y);
+		x += size.x + padding;
+		shelf_height = std::max(shelf_height, size.y);
+	}
+
+	return shelf_y + shelf_height;
+}
@@ -0,0 +1,40 @@
+#ifndef _TEXTURE_ATLAS_INCLUDE
+#define _TEXTURE_ATLAS_INCLUDE
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <glm/glm.hpp>
+#include "Texture.h"
+
+// Copies several images into a single texture, so that sprites drawn from any of them share binds and draw calls.
+// Each image gets a texture that is a view of its rectangle in the atlas (see Texture::setRegion), and since sprites
+// convert their texture coordinates through it they use the view exactly like the original image.
+// Images are placed on shelves, tallest first, a few pixels apart so that neighbours never bleed into each other
+class TextureAtlas
+{
+public:
+	// Loads the images and packs them into one atlas. Returns a view of the atlas for each image, in the same order.
+	// Throws std::runtime_error if an image can't be read or they don't fit in max_size x max_size pixels
+	static std::vector<std::shared_ptr<Texture>> build(std::vector<std::string> const& paths, PixelFormat format,
+		int max_size = S_MAX_SIZE);
+
+	// Places rectangles of the given sizes without overlapping and at least padding pixels apart, writing their top
+	// left corners to positions. Tries every power of two width up to max_size and returns the smallest atlas size,
+	// also powers of two, or (0,0) if they don't fit
+	static glm::ivec2 pack(std::vector<glm::ivec2> const& sizes, int padding, int max_size,
+		std::vector<glm::ivec2>& positions);
+
+	// The default largest side of an atlas, which every OpenGL 3 implementation supports
+	static constexpr int S_MAX_SIZE = 2048;
+
+	// The transparent pixels between two images
+	static constexpr int S_PADDING = 2;
+
+private:
+	// Places the rectangles on shelves of the given width. Returns the height used, or -1 if one is wider
+	static int packShelves(std::vector<glm::ivec2> const& sizes, std::vector<std::size_t> const& order, int padding,
+		int width, std::vector<glm::ivec2>& positions);
+};
+
+#endif // _TEXTURE_ATLAS_INCLUDE
@@ -0,0 +1,67 @@
+#include "TextureCache.h"
+#include "TextureAtlas.h"
+
+#include <iostream>
+
+std::shared_ptr<Texture> TextureCache::get(std::string const& path, PixelFormat format)
+{
+	auto& cache = instance();
+	auto& texture = cache.m_textures[{ path, format }];
+
+	if (texture)
+	{
+		++cache.m_stats.hits;
+		cache.m_stats.bytes_saved += byteSize(*texture, format);
+		return texture;
+	}
+
+	texture = std::make_shared<Texture>();
+	++cache.m_stats.misses;
+
+	if (texture->loadFromFile(path, format))
+		cache.m_stats.bytes_loaded += byteSize(*texture, format);
+	else
+		std::cerr << "TextureCache::get: could not load " << path << std::endl;
+
+	return texture;
+}
+
+void TextureCache::loadAtlas(std::vector<std::string> const& paths, PixelFormat format)
+{
+	auto& cache = instance();
+
+	std::vector<std::string> missing;
+	for (auto const& path : paths)
+	{
+		if (cache.m_textures.count({ path, format }) == 0)
+			missing.push_back(path);
+	}
+	if (missing.empty())
+		return;
+
+	auto regions = TextureAtlas::build(missing, format);
+	for (std::size_t i = 0; i < missing.size(); ++i)
+		cache.m_textures[{ missing[i], format }] = regions[i];
+
+	++cache.m_stats.atlases;
+	cache.m_stats.bytes_loaded += byteSize(regions.front()->getImage(), format);
+}
+
+void TextureCache::clear()
+{
+	instance().m_textures.clear();
+}
+
+void TextureCache::printStats(std::ostream& out)
+{
+	auto const& stats = getStats();
+	out << "Textures: " << size() << " loaded, " << stats.atlases << " atlases, " << stats.hits << " hits, " << stats.misses << " misses, "
+		<< stats.bytes_loaded / 1024 << " KiB uploaded, " << stats.bytes_saved / 1024 << " KiB saved" << std::endl;
+}
+
+std::size_t TextureCache::byteSize(Texture const& texture, PixelFormat format)
+{
+	// The base level only, mipmaps add about a third more
+	std::size_t channels = format == TEXTURE_PIXEL_FORMAT_RGBA ? 4 : 3;
+	return static_cast<std::size_t>(texture.width()) * texture.height() * channels;
+}
@@ -0,0 +1,72 @@
+#ifndef _TEXTURE_CACHE_INCLUDE
+#define _TEXTURE_CACHE_INCLUDE
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Texture.h"
+
+// Counters of how the texture cache has been used
+struct TextureCacheStats
+{
+	// Requests served with an already loaded texture
+	std::size_t hits = 0;
+
+	// Requests that had to decode and upload the image
+	std::size_t misses = 0;
+
+	// Bytes of pixel data decoded and uploaded
+	std::size_t bytes_loaded = 0;
+
+	// Atlases built, whose bytes are part of bytes_loaded
+	std::size_t atlases = 0;
+
+	// Bytes of pixel data that hits did not have to load again
+	std::size_t bytes_saved = 0;
+};
+
+// Hands out shared textures keyed by image file and pixel format, so that each image is decoded and uploaded
+// once no matter how many entities use it. Textures stay loaded until clear() is called.
+// Since they are shared, their wrap and filter parameters should not be changed by whoever gets them
+class TextureCache
+{
+public:
+	// Returns the texture of the image at path, loading it the first time it is asked for
+	static std::shared_ptr<Texture> get(std::string const& path, PixelFormat format);
+
+	// Packs the images into one atlas (see TextureAtlas), so that get() hands out views of it for them. Images that
+	// were already loaded are left as they are
+	static void loadAtlas(std::vector<std::string> const& paths, PixelFormat format);
+
+	// Forgets all textures, which are freed when no one else holds them
+	static void clear();
+
+	// Returns the number of textures loaded
+	static std::size_t size() { return instance().m_textures.size(); }
+
+	// Returns the counters since the start
+	static TextureCacheStats const& getStats() { return instance().m_stats; }
+
+	// Writes the counters in one line
+	static void printStats(std::ostream& out);
+
+private:
+	static TextureCache& instance()
+	{
+		static TextureCache instance;
+		return instance;
+	}
+	TextureCache() = default;
+
+	// Returns the size of the pixel data of a texture
+	static std::size_t byteSize(Texture const& texture, PixelFormat format);
+
+	// The loaded textures
+	std::map<std::pair<std::string, PixelFormat>, std::shared_ptr<Texture>> m_textures;
+
+	TextureCacheStats m_stats;
+};
+
+#endif // _TEXTURE_CACHE_INCLUDE
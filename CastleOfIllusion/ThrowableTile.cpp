@@ -1,6 +1,7 @@
 #include "ThrowableTile.h"
 #include "TimedEvent.h"
 #include "Player.h"
+#include "TextureCache.h"
 
 #include <iostream>
 
@@ -14,8 +15,7 @@ ThrowableTile::ThrowableTile(glm::ivec2 pos,
 	bool destroyed_on_impact) 
 {
 	m_tilemap = tilemap;
-	m_spritesheet.reset(new Texture());
-	m_spritesheet->loadFromFile(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_spritesheet = TextureCache::get(texture_path, TEXTURE_PIXEL_FORMAT_RGBA);
 	m_sprite.reset(Sprite::createSprite(
 		{ tilemap->getTileSize(), tilemap->getTileSize() }, /* quad_size */
 		size_in_texture,
@@ -26,6 +26,7 @@ ThrowableTile::ThrowableTile(glm::ivec2 pos,
 	m_collision_box_size = { tilemap->getTileSize()-2, tilemap->getTileSize() };
 	setPosition(pos);
 	m_destroyed_on_impact = destroyed_on_impact;
+	m_is_throwable = true;
 
 	// Idle "animation" and destroy animation
 	m_sprite->setNumberAnimations(2);
@@ -115,6 +116,23 @@ void ThrowableTile::onThrow(bool looking_right, bool moving)
 	}
 }
 
+void ThrowableTile::onLanding() 
+{
+	if (m_thrown)
+	{
+		if (m_destroyed_on_impact)
+			onDestroy();
+		else
+			m_thrown = false;
+	}
+}
+
+void ThrowableTile::onWallImpact() 
+{
+	if (breaksOnImpact())
+		onDestroy();
+}
+
 void ThrowableTile::onDestroy()
 {
 	m_can_collide = false;
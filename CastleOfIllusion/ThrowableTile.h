@@ -44,9 +44,16 @@ public:
 	// To be called when destroyed
 	virtual void onDestroy();
 
-protected:
-	friend class Entity;
+	// Returns true iff it breaks as soon as it hits something
+	bool breaksOnImpact() const { return m_thrown && m_destroyed_on_impact; }
+
+	// To be called when it lands on a tile or a solid entity
+	void onLanding();
 
+	// To be called when it hits a wall
+	void onWallImpact();
+
+protected:
 	// True if this throwable tile is destroyed on impact with some other throwable tile or an attacking player
 	bool m_destroyed_on_impact;
 
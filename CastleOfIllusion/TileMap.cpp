@@ -2,45 +2,97 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 #include "TileMap.h"
+#include "TextureCache.h"
 
 
 using namespace std;
 
 
-TileMap *TileMap::createTileMap(std::string const& level_file, glm::vec2 const& min_coords, ShaderProgram& program)
+TileMap *TileMap::createTileMap(std::string const& level_file, glm::vec2 const& min_coords, std::shared_ptr<ShaderProgram> program)
 {
 	TileMap *map = new TileMap(level_file, min_coords, program);
 	return map;
 }
 
 
-TileMap::TileMap(std::string const& level_file, glm::vec2 const& min_coords, ShaderProgram& program)
+TileMap::TileMap(std::string const& level_file, glm::vec2 const& min_coords, std::shared_ptr<ShaderProgram> program)
 {
+	m_program = program;
+	m_map_origin_uniform = program->getUniform("mapOrigin");
+	m_tile_size_uniform = program->getUniform("tileSize");
+	m_tilesheet_origin_uniform = program->getUniform("tilesheetOrigin");
+	m_tile_tex_size_uniform = program->getUniform("tileTexSize");
+	m_half_texel_uniform = program->getUniform("halfTexel");
+
 	loadLevel(level_file);
-	prepareArrays(min_coords, program);
+	prepareArrays(min_coords);
 }
 
-TileMap::~TileMap()
+
+void TileMap::render(glm::vec2 const& view_min, glm::vec2 const& view_max) const
 {
-	free();
-}
+	// The chunks the view touches. Tiles are drawn m_block_size wide, which may reach into the next chunk
+	float chunk_pixels = static_cast<float>(S_CHUNK_SIZE * m_tile_size);
+	float overhang = static_cast<float>(std::max(m_block_size - m_tile_size, 0));
+	glm::ivec2 first_chunk = glm::ivec2(glm::floor((view_min - m_position - overhang) / chunk_pixels));
+	glm::ivec2 last_chunk = glm::ivec2(glm::floor((view_max - m_position) / chunk_pixels));
+	first_chunk = glm::max(first_chunk, glm::ivec2(0));
+	last_chunk = glm::min(last_chunk, m_num_chunks - 1);
 
+	// The chunks of a row are consecutive in the instance buffer, so each row is a single range
+	m_draw_first.clear();
+	m_draw_count.clear();
+	m_drawn_tiles = 0;
+	for (int y = first_chunk.y; y <= last_chunk.y && first_chunk.x <= last_chunk.x; ++y)
+	{
+		GLint first = m_chunk_first[y * m_num_chunks.x + first_chunk.x];
+		GLint end = m_chunk_first[y * m_num_chunks.x + last_chunk.x + 1];
+		if (first == end)
+			continue;
+
+		m_draw_first.push_back(first);
+		m_draw_count.push_back(end - first);
+		m_drawn_tiles += end - first;
+	}
+
+#ifndef HEADLESS
+	if (m_draw_first.empty())
+		return;
+
+	// The tilesheet may be a region of an atlas, whose texels are the ones to step back from
+	glm::vec2 half_texel(0.5f / m_tilesheet->getImage().width(), 0.5f / m_tilesheet->getImage().height());
+	glm::vec2 tilesheet_origin = m_tilesheet->toImageCoords(glm::vec2(0.f));
+	glm::vec2 tile_tex_size = m_tilesheet->toImageSize(m_tile_tex_size);
+
+	m_program->setUniform2f(m_map_origin_uniform, m_position.x, m_position.y);
+	m_program->setUniform2f(m_tile_size_uniform, static_cast<float>(m_tile_size), static_cast<float>(m_block_size));
+	m_program->setUniform2f(m_tilesheet_origin_uniform, tilesheet_origin.x, tilesheet_origin.y);
+	m_program->setUniform2f(m_tile_tex_size_uniform, tile_tex_size.x, tile_tex_size.y);
+	m_program->setUniform2f(m_half_texel_uniform, half_texel.x, half_texel.y);
 
-void TileMap::render() const
-{
 	glEnable(GL_TEXTURE_2D);
 	m_tilesheet->use();
-	glBindVertexArray(m_vao);
-	glEnableVertexAttribArray(m_pos_location);
-	glEnableVertexAttribArray(m_texcoord_location);
-	glDrawArrays(GL_TRIANGLES, 0, 6 * m_num_tiles);
+	glBindVertexArray(m_vao.get());
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo.get());
+	glEnableVertexAttribArray(m_tile_location);
+
+	// Without base instances (OpenGL 4.2) each range is drawn by pointing the attribute at its first tile
+	for (std::size_t i = 0; i < m_draw_first.size(); ++i)
+	{
+		glVertexAttribIPointer(m_tile_location, 4, GL_UNSIGNED_SHORT, sizeof(TileInstance),
+			(void *)(m_draw_first[i] * sizeof(TileInstance)));
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 6, m_draw_count[i]);
+	}
 	glDisable(GL_TEXTURE_2D);
+#endif
 }
 
-void TileMap::free()
+std::size_t TileMap::getByteSize() const
 {
-	glDeleteBuffers(1, &m_vbo);
+	return sizeof(TileMap) + m_map.size() * sizeof(int) + (m_solid_rows.size() + m_solid_columns.size()) * sizeof(uint64_t)
+		+ m_chunk_first.size() * sizeof(GLint) + getGpuBytes();
 }
 
 bool TileMap::loadLevel(std::string const& level_file)
@@ -77,8 +129,7 @@ bool TileMap::loadLevel(std::string const& level_file)
 	sstream >> tilesheet_file;
 
 	// Load and configure the tilesheet texture
-	m_tilesheet.reset(new Texture());
-	m_tilesheet->loadFromFile(tilesheet_file, TEXTURE_PIXEL_FORMAT_RGBA);
+	m_tilesheet = TextureCache::get(tilesheet_file, TEXTURE_PIXEL_FORMAT_RGBA);
 	/*m_tilesheet->setWrapS(GL_CLAMP_TO_EDGE);
 	m_tilesheet->setWrapT(GL_CLAMP_TO_EDGE);
 	m_tilesheet->setMinFilter(GL_NEAREST);
@@ -114,135 +165,276 @@ bool TileMap::loadLevel(std::string const& level_file)
 				m_map[j * m_map_size.x + i] = -1;
 			}
 		}
+		// Skip the end of line, which is "\r\n" when a file with Windows line endings is read outside of Windows
 		fin.get(tile_row);
-#ifndef _WIN32
-		fin.get(tile_row);
-#endif
+		if (tile_row == '\r')
+			fin.get(tile_row);
 	}
 	fin.close();
+
+	buildSolidity();
 	
 	return true;
 }
 
-void TileMap::prepareArrays(glm::vec2 const& min_coords, ShaderProgram& program)
+void TileMap::buildSolidity()
+{
+	std::size_t num_words = (m_map.size() + 63) / 64;
+	m_solid_rows.assign(num_words, 0);
+	m_solid_columns.assign(num_words, 0);
+
+	for (int j = 0; j < m_map_size.y; j++)
+	{
+		for (int i = 0; i < m_map_size.x; i++)
+		{
+			if (m_map[j * m_map_size.x + i] == -1)
+				continue;
+
+			std::size_t row_bit = j * m_map_size.x + i;
+			std::size_t column_bit = i * m_map_size.y + j;
+			m_solid_rows[row_bit / 64] |= uint64_t(1) << (row_bit % 64);
+			m_solid_columns[column_bit / 64] |= uint64_t(1) << (column_bit % 64);
+		}
+	}
+}
+
+bool TileMap::anyBitSet(std::vector<uint64_t> const& bits, int64_t first, int64_t last)
+{
+	first = std::max<int64_t>(first, 0);
+	last = std::min<int64_t>(last, int64_t(bits.size()) * 64 - 1);
+	if (first > last)
+		return false;
+
+	std::size_t first_word = first / 64;
+	std::size_t last_word = last / 64;
+	uint64_t first_mask = ~uint64_t(0) << (first % 64);
+	uint64_t last_mask = ~uint64_t(0) >> (63 - last % 64);
+
+	if (first_word == last_word)
+		return (bits[first_word] & first_mask & last_mask) != 0;
+
+	if (bits[first_word] & first_mask)
+		return true;
+
+	for (std::size_t word = first_word + 1; word < last_word; ++word)
+	{
+		if (bits[word] != 0)
+			return true;
+	}
+
+	return (bits[last_word] & last_mask) != 0;
+}
+
+bool TileMap::isRowSolid(int y, int left, int right) const
+{
+	// The tiles of a row are consecutive bits, so the whole range is tested a word at a time
+	int64_t first = int64_t(y) * m_map_size.x + left;
+	int64_t last = int64_t(y) * m_map_size.x + right;
+	return anyBitSet(m_solid_rows, first, last);
+}
+
+bool TileMap::isColumnSolid(int x, int top, int bottom) const
+{
+	if (x < 0 || x >= m_map_size.x)
+	{
+		// Out of the map, each tile is looked up as the rows do, wrapping around into other rows
+		for (int y = top; y <= bottom; y++)
+		{
+			if (isRowSolid(y, x, x))
+				return true;
+		}
+		return false;
+	}
+
+	top = std::max(top, 0);
+	bottom = std::min(bottom, m_map_size.y - 1);
+	int64_t first = int64_t(x) * m_map_size.y + top;
+	int64_t last = int64_t(x) * m_map_size.y + bottom;
+	return anyBitSet(m_solid_columns, first, last);
+}
+
+void TileMap::prepareArrays(glm::vec2 const& min_coords)
 {
-	int tile;
-	glm::vec2 pos_tile, texcoord_tile[2], half_texel;
-	vector<float> vertices;
-	
 	m_num_tiles = 0;
-	half_texel = glm::vec2(0.5f / m_tilesheet->width(), 0.5f / m_tilesheet->height());
-	for (int j=0; j<m_map_size.y; j++)
+	m_position = min_coords;
+	m_num_chunks = (m_map_size + S_CHUNK_SIZE - 1) / S_CHUNK_SIZE;
+	m_chunk_first.clear();
+
+	std::vector<TileInstance> instances;
+	for (int chunk_y = 0; chunk_y < m_num_chunks.y; chunk_y++)
 	{
-		for (int i=0; i<m_map_size.x; i++)
+		for (int chunk_x = 0; chunk_x < m_num_chunks.x; chunk_x++)
 		{
-			tile = m_map[j * m_map_size.x + i];
-			if (tile != -1)
+			m_chunk_first.push_back(m_num_tiles);
+
+			int last_j = std::min((chunk_y + 1) * S_CHUNK_SIZE, m_map_size.y);
+			int last_i = std::min((chunk_x + 1) * S_CHUNK_SIZE, m_map_size.x);
+			for (int j = chunk_y * S_CHUNK_SIZE; j < last_j; j++)
 			{
-				// Non-empty tile
-				m_num_tiles++;
-				pos_tile = glm::vec2(min_coords.x + i * m_tile_size, min_coords.y + j * m_tile_size);
-				texcoord_tile[0] = glm::vec2(float((tile)%m_tilesheet_size.x) / m_tilesheet_size.x,
-											 float((tile)/m_tilesheet_size.x) / m_tilesheet_size.y);
-				texcoord_tile[1] = texcoord_tile[0] + m_tile_tex_size;
-				//texcoord_tile[0] += half_texel;
-				texcoord_tile[1] -= half_texel;
-				// First triangle
-				vertices.push_back(pos_tile.x); vertices.push_back(pos_tile.y);
-				vertices.push_back(texcoord_tile[0].x); vertices.push_back(texcoord_tile[0].y);
-				vertices.push_back(pos_tile.x + m_block_size); vertices.push_back(pos_tile.y);
-				vertices.push_back(texcoord_tile[1].x); vertices.push_back(texcoord_tile[0].y);
-				vertices.push_back(pos_tile.x + m_block_size); vertices.push_back(pos_tile.y + m_block_size);
-				vertices.push_back(texcoord_tile[1].x); vertices.push_back(texcoord_tile[1].y);
-				// Second triangle
-				vertices.push_back(pos_tile.x); vertices.push_back(pos_tile.y);
-				vertices.push_back(texcoord_tile[0].x); vertices.push_back(texcoord_tile[0].y);
-				vertices.push_back(pos_tile.x + m_block_size); vertices.push_back(pos_tile.y + m_block_size);
-				vertices.push_back(texcoord_tile[1].x); vertices.push_back(texcoord_tile[1].y);
-				vertices.push_back(pos_tile.x); vertices.push_back(pos_tile.y + m_block_size);
-				vertices.push_back(texcoord_tile[0].x); vertices.push_back(texcoord_tile[1].y);
+				for (int i = chunk_x * S_CHUNK_SIZE; i < last_i; i++)
+				{
+					int tile = m_map[j * m_map_size.x + i];
+					if (tile != -1)
+					{
+						// Non-empty tile, the shader works out the rest
+						m_num_tiles++;
+						instances.push_back({ static_cast<uint16_t>(i), static_cast<uint16_t>(j),
+							static_cast<uint16_t>(tile % m_tilesheet_size.x), static_cast<uint16_t>(tile / m_tilesheet_size.x) });
+					}
+				}
 			}
 		}
 	}
+	m_chunk_first.push_back(m_num_tiles);
 
-	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
-	glGenBuffers(1, &m_vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, 24 * m_num_tiles * sizeof(float), &vertices[0], GL_STATIC_DRAW);
-	m_pos_location = program.bindVertexAttribute("position", 2, 4*sizeof(float), 0);
-	m_texcoord_location = program.bindVertexAttribute("texCoord", 2, 4*sizeof(float), (void *)(2*sizeof(float)));
+#ifndef HEADLESS
+	// No vertices: the shader makes the corners of the quad from gl_VertexID
+	m_vao = GLVertexArray::generate();
+	glBindVertexArray(m_vao.get());
+	m_vbo = GLBuffer::generate();
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo.get());
+	glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(TileInstance), instances.data(), GL_STATIC_DRAW);
+	m_tile_location = m_program->bindInstanceAttribute("tile", 4, GL_UNSIGNED_SHORT, sizeof(TileInstance), 0);
+#endif
 }
 
 
 std::optional<glm::ivec2> TileMap::xCollision(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity) const
 {
-	int left, right, top, bottom;
+	if (auto impact = xSweep(pos, size, velocity, 0))
+		return impact->pos;
+
+	return std::nullopt;
+}
+
+std::optional<glm::ivec2> TileMap::yCollision(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity) const
+{
+	if (auto impact = ySweep(pos, size, velocity, 0))
+		return impact->pos;
+
+	return std::nullopt;
+}
+
+std::optional<TileImpact> TileMap::xSweep(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity, int displacement) const
+{
+	int top, bottom;
 	
-	left = pos.x / m_tile_size;
-	right = (pos.x + size.x - 1) / m_tile_size;
 	top = pos.y / m_tile_size;
 	bottom = (pos.y + size.y - 1) / m_tile_size;
 
+	auto Impact = [&](int x) 
+	{
+		return TileImpact { glm::ivec2(x, pos.y), displacement != 0 ? std::clamp(float(x - pos.x) / displacement, 0.f, 1.f) : 0.f };
+	};
+
+	// The columns between the start and the end are only walked when moving more than a tile, otherwise only 
+	// the column at the end is checked
 	if (velocity.x > 0.f) // Moving right
 	{
-		for (int y=top; y<=bottom; y++)
+		int start = (pos.x + size.x - 1) / m_tile_size;
+		int end = (pos.x + displacement + size.x - 1) / m_tile_size;
+		for (int x = start + 1; x <= end; x++)
 		{
-			int accessPos = y * m_map_size.x + right;
-			if (accessPos < m_map.size() && m_map[accessPos] != -1)
-			{
-				return glm::vec2(m_tile_size * right - size.x, pos.y);
-			}
+			if (isColumnSolid(x, top, bottom))
+				return Impact(m_tile_size * x - size.x);
 		}
+		if (end <= start && isColumnSolid(end, top, bottom))
+			return Impact(m_tile_size * end - size.x);
 	}
 	else { // Moving left
-		for (int y=top; y<=bottom; y++)
+		int start = pos.x / m_tile_size;
+		int end = (pos.x + displacement) / m_tile_size;
+		for (int x = start - 1; x >= end; x--)
 		{
-			int accessPos = y * m_map_size.x + left;
-			if (accessPos < m_map.size() && m_map[accessPos] != -1)
-			{
-				return glm::vec2(m_tile_size * (left+1), pos.y);
-			}
+			if (isColumnSolid(x, top, bottom))
+				return Impact(m_tile_size * (x+1));
 		}
+		if (end >= start && isColumnSolid(end, top, bottom))
+			return Impact(m_tile_size * (end+1));
 	}
 
 	return std::nullopt;
 }
 
-std::optional<glm::ivec2> TileMap::yCollision(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity) const
+std::optional<TileImpact> TileMap::ySweep(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity, int displacement) const
 {
-	int left, right, top, bottom;
+	int left, right;
 	
 	left = pos.x / m_tile_size;
 	right = (pos.x + size.x - 1) / m_tile_size;
-	top = pos.y / m_tile_size;
-	bottom = (pos.y + size.y - 1) / m_tile_size;
 
+	auto Impact = [&](int y) 
+	{
+		return TileImpact { glm::ivec2(pos.x, y), displacement != 0 ? std::clamp(float(y - pos.y) / displacement, 0.f, 1.f) : 0.f };
+	};
+
+	// The rows between the start and the end are only walked when moving more than a tile, otherwise only 
+	// the row at the end is checked
 	if (velocity.y > 0.f) // Falling
 	{
-		for (int x=left; x<=right; x++)
+		int start = (pos.y + size.y - 1) / m_tile_size;
+		int end = (pos.y + displacement + size.y - 1) / m_tile_size;
+		for (int y = start + 1; y <= end; y++)
 		{
-			int accessPos = bottom * m_map_size.x + x;
-			if (accessPos < m_map.size() && m_map[accessPos] != -1)
-			{
-				return glm::vec2(pos.x, m_tile_size * bottom - size.y);
-			}
+			if (isRowSolid(y, left, right))
+				return Impact(m_tile_size * y - size.y);
 		}
+		if (end <= start && isRowSolid(end, left, right))
+			return Impact(m_tile_size * end - size.y);
 	}
 	else
 	{
-		for (int x=left; x<=right; x++)
+		int start = pos.y / m_tile_size;
+		int end = (pos.y + displacement) / m_tile_size;
+		for (int y = start - 1; y >= end; y--)
 		{
-			int accessPos = top * m_map_size.x + x;
-			if (accessPos < m_map.size() && m_map[accessPos] != -1)
-			{
-				return glm::vec2(pos.x, m_tile_size * (top+1));
-			}
+			if (isRowSolid(y, left, right))
+				return Impact(m_tile_size * (y+1));
 		}
+		if (end >= start && isRowSolid(end, left, right))
+			return Impact(m_tile_size * (end+1));
 	}
+
 	return std::nullopt;
 }
 
+void TileMap::resolveBodies(std::vector<TileBody>& bodies) const
+{
+	for (auto& body : bodies)
+	{
+		body.x_impact = false;
+		body.y_impact = false;
+		body.grounded = false;
+
+		if (!body.collides)
+		{
+			body.pos += body.displacement;
+			continue;
+		}
+
+		if (auto impact = ySweep(body.pos, body.size, body.velocity, body.displacement.y))
+		{
+			body.pos.y = impact->pos.y;
+			body.y_impact = true;
+		}
+		else
+			body.pos.y += body.displacement.y;
+
+		body.grounded = isGrounded(body.pos, body.size);
+
+		if (body.y_impact && body.stops_on_y_impact)
+			continue;
+
+		if (auto impact = xSweep(body.pos, body.size, body.velocity, body.displacement.x))
+		{
+			body.pos.x = impact->pos.x;
+			body.x_impact = true;
+		}
+		else
+			body.pos.x += body.displacement.x;
+	}
+}
+
 bool TileMap::isGrounded(glm::ivec2 const& pos, glm::ivec2 const& size) const
 {
 	int left, right, y;
@@ -250,15 +442,7 @@ bool TileMap::isGrounded(glm::ivec2 const& pos, glm::ivec2 const& size) const
 	left = pos.x / m_tile_size;
 	right = (pos.x + size.x - 1) / m_tile_size;
 	y = (pos.y + size.y) / m_tile_size;
-	for (int x=left; x<=right; x++)
-	{
-		int accessPos = y * m_map_size.x + x;
-		if (accessPos < m_map.size() && m_map[accessPos] != -1)
-		{
-			return true;
-		}
-	}
-	return false;
+	return isRowSolid(y, left, right);
 }
 
 std::shared_ptr<Texture> TileMap::getTilesheet() const 
@@ -7,29 +7,85 @@
 #include <glm/glm.hpp>
 #include "Texture.h"
 #include "ShaderProgram.h"
+#include "GLHandle.h"
 #include <optional>
+#include <cstdint>
 
 
 // Class Tilemap is capable of loading a tile map from a text file in a simple format
 // (see test.txt for an example). Tiles are indexed with 2 characters from a to z refering
 // to its row and column in the tilesheet, a being 0 and z being 26. An empty tile is 
-// represented with '..'. With this information it builds a single VBO that contains all tiles.
-// As a result the render method draws the whole map independently of what is visible.
+// represented with '..'. With this information it builds a single buffer with one instance per tile,
+// which is just where it is in the map and in the tilesheet; the shader (tilemap.vert) builds the quad
+// and its texture coordinates from it. Tiles are grouped in square chunks, so that the render method
+// only draws the chunks that are visible.
 
 
 
 
+// Where a rectangle moving along one axis first touches a solid tile
+struct TileImpact
+{
+	// The position of the rectangle right before colliding
+	glm::ivec2 pos;
+
+	// The fraction of the movement done before colliding, from 0 to 1
+	float time;
+};
+
+// A moving rectangle, as given to and returned by TileMap::resolveBodies
+struct TileBody
+{
+	// The top left corner of the rectangle, which is updated to where it ends up
+	glm::ivec2 pos;
+
+	// The size of the rectangle
+	glm::ivec2 size;
+
+	// The velocity, which tells in which direction to check each axis
+	glm::vec2 velocity;
+
+	// How much it has to move on each axis
+	glm::ivec2 displacement;
+
+	// True iff it collides with the tiles, otherwise it just moves
+	bool collides;
+
+	// True iff it does not move horizontally after colliding vertically, which is what happens to a throwable tile
+	// that breaks when it lands (see Entity::getTileBody)
+	bool stops_on_y_impact;
+
+	// Set to true iff it collided on each axis
+	bool x_impact;
+	bool y_impact;
+
+	// Set to true iff it ended up on top of a tile
+	bool grounded;
+};
+
 class TileMap
 {
 
 public:
-	// Tile maps can only be created inside an OpenGL context
-	static TileMap *createTileMap(std::string const& level_file, glm::vec2 const& min_coords, ShaderProgram &program);
+	// Tile maps can only be created inside an OpenGL context, unless built with HEADLESS defined,
+	// in which case nothing is sent to the GPU
+	static TileMap *createTileMap(std::string const& level_file, glm::vec2 const& min_coords, std::shared_ptr<ShaderProgram> program);
+
+	// Renders the chunks of the tilemap that intersect the rectangle from view_min to view_max. The program the map
+	// was created with has to be in use, with its projection and color set
+	void render(glm::vec2 const& view_min, glm::vec2 const& view_max) const;
+
+	// Returns the number of tiles the last render drew
+	int getDrawnTiles() const { return m_drawn_tiles; }
+
+	// Returns the number of non-empty tiles
+	int getNumTiles() const { return m_num_tiles; }
 
-	~TileMap();
+	// Returns the size of the tile instances on the GPU
+	std::size_t getGpuBytes() const { return m_num_tiles * sizeof(TileInstance); }
 
-	// Renders the tilemap
-	void render() const;
+	// Returns the size of the map in memory and on the GPU
+	std::size_t getByteSize() const;
 	
 	// Returns the size of one tile
 	int getTileSize() const { return m_tile_size; }
@@ -44,35 +100,91 @@ public:
 	
 	bool isGrounded(glm::ivec2 const& pos, glm::ivec2 const& size) const;
 
+	// Moves a rectangle at the position and of the size provided horizontally by displacement pixels, going
+	// through every column of tiles its front side crosses, so that it can't go through thin walls when it
+	// moves more than a tile at once. If it collides, returns where it stopped and when
+	std::optional<TileImpact> xSweep(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity, int displacement) const;
+
+	// Same as xSweep, but vertically
+	std::optional<TileImpact> ySweep(glm::ivec2 const& pos, glm::ivec2 const& size, glm::vec2 const& velocity, int displacement) const;
+
+	// Moves all bodies, first vertically and then horizontally, stopping them at the tiles they collide with
+	void resolveBodies(std::vector<TileBody>& bodies) const;
+
 	std::shared_ptr<Texture> getTilesheet() const;
 	
 private:
 	// Private constructor for the factory pattern
-	TileMap(std::string const& level_file, glm::vec2 const& min_coords, ShaderProgram& program);
-
-	void free();
+	TileMap(std::string const& level_file, glm::vec2 const& min_coords, std::shared_ptr<ShaderProgram> program);
 
 	// Loads a level
 	bool loadLevel(std::string const& level_file);
-	void prepareArrays(glm::vec2 const& min_coords, ShaderProgram& program);
+	void prepareArrays(glm::vec2 const& min_coords);
+
+	// Fills the solidity grids from the map
+	void buildSolidity();
+
+	// Checks if any tile in the given row, from column left to column right, is solid. Like the map, the row
+	// wraps around into the next one if the columns are out of range
+	bool isRowSolid(int y, int left, int right) const;
+
+	// Checks if any tile in the given column, from row top to row bottom, is solid
+	bool isColumnSolid(int x, int top, int bottom) const;
+
+	// Checks if any bit from first to last, both included, is set. Bits out of range are not set
+	static bool anyBitSet(std::vector<uint64_t> const& bits, int64_t first, int64_t last);
 
 private:
-	// The tilemap's VAO
-	GLuint m_vao;
+	// What the GPU gets of a tile: its position in the map and in the tilesheet, in tiles
+	struct TileInstance
+	{
+		uint16_t x;
+		uint16_t y;
+		uint16_t column;
+		uint16_t row;
+	};
+
+	// The program that draws the tiles
+	std::shared_ptr<ShaderProgram> m_program;
+
+	// The uniforms of the program that depend on the map
+	UniformHandle m_map_origin_uniform;
+	UniformHandle m_tile_size_uniform;
+	UniformHandle m_tilesheet_origin_uniform;
+	UniformHandle m_tile_tex_size_uniform;
+	UniformHandle m_half_texel_uniform;
 
-	// The tilemap's VBO
-	GLuint m_vbo;
+	// The tilemap's VAO
+	GLVertexArray m_vao;
 
-	// The pos location in the shader
-	GLint m_pos_location; 
+	// The tilemap's VBO, with a TileInstance per tile
+	GLBuffer m_vbo;
 
-	// The texture coord location in the shader
-	GLint m_texcoord_location;
+	// The tile instance location in the shader
+	GLint m_tile_location;
 
 	// The number of tiles
 	int m_num_tiles;
 
-	glm::ivec2 m_position;
+	// The side of a chunk, in tiles
+	static constexpr int S_CHUNK_SIZE = 16;
+
+	// The number of chunks in each axis
+	glm::ivec2 m_num_chunks;
+
+	// The first tile of each chunk, row by row, followed by the number of tiles. The tiles of chunk i go from
+	// m_chunk_first[i] to m_chunk_first[i + 1], and so do those of several consecutive chunks in a row
+	std::vector<GLint> m_chunk_first;
+
+	// The tile ranges of the last render, kept to avoid allocating every frame
+	mutable std::vector<GLint> m_draw_first;
+	mutable std::vector<GLsizei> m_draw_count;
+
+	// The number of tiles the last render drew
+	mutable int m_drawn_tiles = 0;
+
+	// The top left corner of the map
+	glm::vec2 m_position;
 
 	glm::ivec2 m_map_size;
 	
@@ -95,6 +207,12 @@ private:
 	// Stores the index of each tile, -1 indicates an empty tile
 	std::vector<int> m_map;
 
+	// One bit per tile telling if it is solid, row by row, packed in 64 bit words
+	std::vector<uint64_t> m_solid_rows;
+
+	// The same bits column by column, so that scans through a column also read consecutive bits
+	std::vector<uint64_t> m_solid_columns;
+
 };
 
 
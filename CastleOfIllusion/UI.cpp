@@ -1,5 +1,6 @@
 #include "UI.h"
 #include "Game.h"
+#include "TextureCache.h"
 
 #include <iostream>
 
@@ -18,17 +19,14 @@ void UI::init(std::shared_ptr<ShaderProgram> shader_program, Screen mode)
 	case Screen::StrartScreen:
 	{
 		// Base sprite
-		m_base_spritesheet.reset(new Texture());
-		m_base_spritesheet->loadFromFile("images/StartScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_base_spritesheet = TextureCache::get("images/StartScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_base_sprite.reset(Sprite::createSprite(glm::ivec2(SCREEN_WIDTH, SCREEN_HEIGHT), glm::vec2(1.f, 1.f), m_base_spritesheet, shader_program));
 
 		//Buttons
-		m_selection_arrow_spritesheet.reset(new Texture());
-		m_selection_arrow_spritesheet->loadFromFile("images/arrow.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_selection_arrow_spritesheet = TextureCache::get("images/arrow.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_selection_arrow.reset(Sprite::createSprite(glm::ivec2(8.f * 2.f, 8.f * 2.f), glm::vec2(1.f, 1.f), m_selection_arrow_spritesheet, shader_program));
 
-		m_startscreen_buttons_spritesheet.reset(new Texture());
-		m_startscreen_buttons_spritesheet->loadFromFile("images/StartScreenText.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_startscreen_buttons_spritesheet = TextureCache::get("images/StartScreenText.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_startscreen_buttons.clear();
 		m_startscreen_buttons.resize(3);
 		for (int i = 0; i < m_startscreen_buttons.size(); ++i)
@@ -44,16 +42,14 @@ void UI::init(std::shared_ptr<ShaderProgram> shader_program, Screen mode)
 	case Screen::Level:
 	{
 		// Get the time at creation
-		m_start_application_time = glfwGetTime();
+		m_start_application_time = getTime();
 
 		// Base sprite
-		m_base_spritesheet.reset(new Texture());
-		m_base_spritesheet->loadFromFile("images/UIBase.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_base_spritesheet = TextureCache::get("images/UIBase.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_base_sprite.reset(Sprite::createSprite(glm::ivec2(16 * 16 * 4, 2 * 16 * 4), glm::vec2(1.f, 1.f), m_base_spritesheet, shader_program));
 
 		// Power sprites
-		m_power_spritesheet.reset(new Texture());
-		m_power_spritesheet->loadFromFile("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_power_spritesheet = TextureCache::get("images/Items.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_power_sprite = std::vector<std::shared_ptr<Sprite>>(3);
 		for (int i = 0; i < m_power_sprite.size(); ++i)
 		{
@@ -79,16 +75,14 @@ void UI::init(std::shared_ptr<ShaderProgram> shader_program, Screen mode)
 	case Screen::Options:
 	{
 		// Base sprite
-		m_base_spritesheet.reset(new Texture());
-		m_base_spritesheet->loadFromFile("images/ControlsScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_base_spritesheet = TextureCache::get("images/ControlsScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_base_sprite.reset(Sprite::createSprite(glm::ivec2(SCREEN_WIDTH, SCREEN_HEIGHT), glm::vec2(1.f, 1.f), m_base_spritesheet, shader_program));
 		break;
 	}
 	case Screen::Credits:
 	{
 		// Base sprite
-		m_base_spritesheet.reset(new Texture());
-		m_base_spritesheet->loadFromFile("images/CreditsScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
+		m_base_spritesheet = TextureCache::get("images/CreditsScreen.png", TEXTURE_PIXEL_FORMAT_RGBA);
 		m_base_sprite.reset(Sprite::createSprite(glm::ivec2(SCREEN_WIDTH, SCREEN_HEIGHT), glm::vec2(1.f, 1.f), m_base_spritesheet, shader_program));
 		break;
 	}
@@ -96,9 +90,9 @@ void UI::init(std::shared_ptr<ShaderProgram> shader_program, Screen mode)
 
 }
 
-void UI::render()
+void UI::render(SpriteBatch& batch)
 {
-	m_base_sprite->render();
+	m_base_sprite->render(batch);
 	switch (m_current_mode)
 	{
 	case Screen::StrartScreen:
@@ -108,19 +102,19 @@ void UI::render()
 			{
 				m_selection_arrow->setPosition(glm::vec2(512.f - m_startscreen_buttons[i]->getQuadSize().x/2.f - 12.f, 320.f - 8.f + i * (8.f+m_startscreen_buttons[i]->getQuadSize().y)));
 			}
-			m_startscreen_buttons[i]->render();
-			m_selection_arrow->render();
+			m_startscreen_buttons[i]->render(batch);
+			m_selection_arrow->render(batch);
 		}
 		break;
 	case Screen::Tutorial:
 	case Screen::Level:
-		m_tries_text->render();
-		m_score_text->render();
-		m_time_text->render();
+		m_tries_text->render(batch);
+		m_score_text->render(batch);
+		m_time_text->render(batch);
 
 		for (int i = 0; i < m_power_sprite.size(); ++i)
 		{
-			m_power_sprite[i]->render();
+			m_power_sprite[i]->render(batch);
 		}
 		break;
 	case Screen::Options:
@@ -132,6 +126,8 @@ void UI::render()
 
 void UI::update(int delta_time)
 {
+	m_simulated_time += delta_time / 1000.0;
+
 	switch (m_current_mode)
 	{
 	case Screen::StrartScreen:
@@ -174,7 +170,7 @@ void UI::update(int delta_time)
 	{
 		// Calculate the time left
 		// It doesn't work well with delta_time, it somehow builds up an error
-		m_time_left = m_start_level_time - static_cast<int>((glfwGetTime()) - m_start_application_time);
+		m_time_left = m_start_level_time - static_cast<int>((getTime()) - m_start_application_time);
 
 
 		m_base_sprite->setPosition(m_pos);
@@ -221,6 +217,16 @@ void UI::update(int delta_time)
 	}
 }
 
+double UI::getTime() const
+{
+#ifdef HEADLESS
+	// There is no window library without a window, and the simulation may run faster than real time
+	return m_simulated_time;
+#else
+	return glfwGetTime();
+#endif
+}
+
 void UI::setPosition(glm::vec2 pos)
 {
 	m_pos = pos;
@@ -18,8 +18,8 @@ public:
 
 	void init(std::shared_ptr<ShaderProgram> shader_program, Screen mode);
 
-	// Renders the UI
-	void render();
+	// Adds the UI to the batch of sprites being rendered
+	void render(SpriteBatch& batch);
 
 	// Updates the UI values
 	void update(int delta_time);
@@ -47,6 +47,9 @@ private:
 
 	void changeScreen(Screen screen_id);
 
+	// Returns the time in seconds, from the window library or simulated in headless builds
+	double getTime() const;
+
 	std::function<void(Screen)> m_change_screen_callback;
 
 	// The coordinates of the midpoint in the base the UI
@@ -74,6 +77,9 @@ private:
 
 	int m_start_level_time = 400;
 	double m_start_application_time;
+
+	// The time (s) accumulated from update calls
+	double m_simulated_time = 0.0;
 	int m_time_left;
 
 	// The text that displays the number of tries left
@@ -0,0 +1,2 @@
+g++ -O2 -ffp-contract=off -std=c++17 -DHEADLESS -I.. $(ls ../*.cpp | grep -v '/main.cpp$') headless.cpp -o headless
+g++ -O2 -ffp-contract=off -std=c++17 -DHEADLESS -I.. $(ls ../*.cpp | grep -v '/main.cpp$') impact_bench.cpp -o impact_bench
@@ -0,0 +1,218 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Game.h"
+#include "../Entity.h"
+#include "../PhysicsBodies.h"
+#include "../TextureCache.h"
+
+// Steps the game at full CPU speed without a window or an OpenGL context, for automated playthroughs.
+// Has to be built with HEADLESS defined (see compile.sh) and run from the game directory so that levels/ is found.
+//
+// Usage: headless <tutorial|level> <frames> [delta_time_ms] [input_file] [--broadphase=<loop|hash|sap>] [--physics=<simd|scalar>] [--activity-margin=<pixels|off>]
+//
+// The input file has one key event per line:
+// <frame> <press|release> <key>
+// where key is one of w a s d k h g enter
+
+#define DEFAULT_DELTA_TIME 16
+
+struct KeyEvent
+{
+	int frame;
+	bool pressed;
+	int key;
+};
+
+int keyFromName(std::string const& name)
+{
+	if (name == "enter")
+		return GLFW_KEY_ENTER;
+	if (name.size() == 1 && name[0] >= 'a' && name[0] <= 'z')
+		return GLFW_KEY_A + (name[0] - 'a');
+
+	std::cerr << "Unknown key: " << name << std::endl;
+	std::exit(-1);
+}
+
+std::multimap<int, KeyEvent> readInput(std::string const& path)
+{
+	std::multimap<int, KeyEvent> events;
+	std::ifstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Could not read input file " << path << std::endl;
+		std::exit(-1);
+	}
+
+	std::string line;
+	while (getline(file, line))
+	{
+		std::istringstream split_line(line);
+		KeyEvent event;
+		std::string action, key;
+
+		if (!(split_line >> event.frame >> action >> key))
+			continue;
+
+		event.pressed = (action == "press");
+		event.key = keyFromName(key);
+		events.emplace(event.frame, event);
+	}
+
+	return events;
+}
+
+// Hashes the position and velocity of every enabled entity, so that two runs can be compared
+uint64_t hashState(Scene const& scene)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	auto Mix = [&hash](int32_t value)
+	{
+		hash ^= static_cast<uint32_t>(value);
+		hash *= 1099511628211ull;
+	};
+
+	for (auto const& entity : scene.getEntities())
+	{
+		Mix(entity->isEnabled());
+		if (!entity->isEnabled())
+			continue;
+
+		Mix(entity->getPosition().x);
+		Mix(entity->getPosition().y);
+		Mix(static_cast<int32_t>(entity->getVelocity().x * 1000.0f));
+		Mix(static_cast<int32_t>(entity->getVelocity().y * 1000.0f));
+	}
+
+	return hash;
+}
+
+BroadphaseType broadphaseFromName(std::string const& name)
+{
+	if (name == "loop")
+		return BroadphaseType::NestedLoop;
+	if (name == "hash")
+		return BroadphaseType::SpatialHash;
+	if (name == "sap")
+		return BroadphaseType::SweepAndPrune;
+
+	std::cerr << "Unknown broadphase: " << name << std::endl;
+	std::exit(-1);
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> args;
+	std::string const broadphase_option = "--broadphase=";
+	std::string broadphase = "hash";
+	std::string const physics_option = "--physics=";
+	std::string physics = "simd";
+	std::string const activity_margin_option = "--activity-margin=";
+	std::string activity_margin = std::to_string(DEFAULT_ACTIVITY_MARGIN);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg.compare(0, broadphase_option.size(), broadphase_option) == 0)
+			broadphase = arg.substr(broadphase_option.size());
+		else if (arg.compare(0, physics_option.size(), physics_option) == 0)
+			physics = arg.substr(physics_option.size());
+		else if (arg.compare(0, activity_margin_option.size(), activity_margin_option) == 0)
+			activity_margin = arg.substr(activity_margin_option.size());
+		else
+			args.push_back(arg);
+	}
+
+	if (args.size() < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <tutorial|level> <frames> [delta_time_ms] [input_file] [--broadphase=<loop|hash|sap>] [--physics=<simd|scalar>] [--activity-margin=<pixels|off>]" << std::endl;
+		return -1;
+	}
+
+	std::string level = args[0];
+	int frames = std::atoi(args[1].c_str());
+	int delta_time = args.size() > 2 ? std::atoi(args[2].c_str()) : DEFAULT_DELTA_TIME;
+	std::multimap<int, KeyEvent> input;
+	if (args.size() > 3)
+		input = readInput(args[3]);
+
+	Game::init();
+	Game::getScene().setBroadphase(broadphaseFromName(broadphase));
+
+	if (physics != "simd" && physics != "scalar")
+	{
+		std::cerr << "Unknown physics integration: " << physics << std::endl;
+		return -1;
+	}
+	PhysicsBodies::setVectorized(physics == "simd");
+
+	// Without activity regions every entity is updated every frame
+	Game::getScene().setActivityMargin(activity_margin == "off" ? -1 : std::atoi(activity_margin.c_str()));
+
+	if (level == "tutorial")
+		Game::getScene().setScreen(Screen::Tutorial);
+	else if (level == "level")
+		Game::getScene().setScreen(Screen::Level);
+	else
+	{
+		std::cerr << "Unknown level: " << level << std::endl;
+		return -1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	int frame = 0;
+	for (; frame < frames; ++frame)
+	{
+		auto [first, last] = input.equal_range(frame);
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second.pressed)
+				Game::keyPressed(it->second.key);
+			else
+				Game::keyReleased(it->second.key);
+		}
+
+		if (!Game::update(delta_time))
+			break;
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(end - start).count();
+
+	// Renders the last frame once, which without a GPU only counts the quads, draw calls and uniforms it would take
+	UniformStats uniforms_before = Game::getScene().getShaderProgram().getUniformStats();
+	Game::getScene().render();
+	SpriteBatch const& sprite_batch = Game::getScene().getSpriteBatch();
+	UniformStats const& uniforms_after = Game::getScene().getShaderProgram().getUniformStats();
+
+	std::cout << "Broadphase: " << broadphase << std::endl;
+	std::cout << "Physics: " << physics << std::endl;
+	std::cout << "Activity margin: " << activity_margin << std::endl;
+	std::cout << "Simulated " << frame << " frames (" << frame * delta_time / 1000.0 << " s of game time) in "
+		<< seconds << " s, " << frame / seconds << " frames/s" << std::endl;
+	std::cout << "Entities: " << Game::getScene().getEntities().size() << std::endl;
+	std::cout << "State hash: " << std::hex << hashState(Game::getScene()) << std::dec << std::endl;
+	std::cout << "Sprites: " << sprite_batch.getQuads() << " quads in " << sprite_batch.getDrawCalls() << " draw calls" << std::endl;
+	if (Game::getScene().getTileMap())
+	{
+		auto const& tilemap = Game::getScene().getTileMap();
+		std::cout << "Tiles: " << tilemap->getDrawnTiles() << " of " << tilemap->getNumTiles() << " drawn in the last frame, "
+			<< tilemap->getGpuBytes() << " bytes of instances" << std::endl;
+	}
+	std::cout << "Uniforms: " << uniforms_after.sets - uniforms_before.sets << " set, "
+		<< uniforms_after.lookups - uniforms_before.lookups << " looked up by name in the last frame" << std::endl;
+	TextureCache::printStats(std::cout);
+
+	return 0;
+}
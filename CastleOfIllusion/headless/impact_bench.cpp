@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../Coin.h"
+#include "../Box.h"
+#include "../Rock.h"
+#include "../ThrowableTile.h"
+#include "../PhysicsBodies.h"
+
+// Microbenchmark for the tile impacts of a scene full of bouncing coins, with a box or a rock every few of them.
+// Each frame, every entity is updated and moved through the tilemap like Scene does, so most of them land on the
+// floor every frame. Every tile impact is recorded, and then the check the physics does on each of them to know
+// whether the entity is a ThrowableTile is timed over that same sequence, both with the old dynamic_cast and with
+// the type tag stored in Entity.
+// Has to be built with HEADLESS defined (see compile.sh) and run from the game directory so that levels/ is found.
+//
+// Usage: impact_bench [entities] [frames]
+
+#define DEFAULT_ENTITIES 10000
+#define DEFAULT_FRAMES 1000
+#define DELTA_TIME 16
+
+// One entity in this many is a throwable tile, alternating boxes and rocks
+#define THROWABLE_EVERY 8
+
+template <typename Function>
+double timeIt(Function&& function)
+{
+	auto start = std::chrono::steady_clock::now();
+	function();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	int num_entities = argc > 1 ? std::atoi(argv[1]) : DEFAULT_ENTITIES;
+	int frames = argc > 2 ? std::atoi(argv[2]) : DEFAULT_FRAMES;
+
+	auto tile_program = std::make_shared<ShaderProgram>();
+	std::shared_ptr<TileMap> tilemap(TileMap::createTileMap("levels/tutorial.txt", glm::vec2(0, 0), tile_program));
+	std::shared_ptr<ShaderProgram> shader_program(new ShaderProgram());
+
+	// Drop the entities from different heights along the first screens of the tutorial
+	std::mt19937 random(42);
+	std::vector<std::shared_ptr<Entity>> entities;
+	for (int i = 0; i < num_entities; ++i)
+	{
+		glm::ivec2 pos(64 + random() % (20 * 64), 64 + random() % (4 * 64));
+		std::shared_ptr<Entity> entity;
+		if (i % THROWABLE_EVERY != THROWABLE_EVERY - 1)
+			entity = std::make_shared<Coin>(pos, tilemap, glm::ivec2(0, 0), shader_program, i % 2 == 0);
+		else if (i / THROWABLE_EVERY % 2 == 0)
+			entity = std::make_shared<Box>(pos, tilemap, shader_program);
+		else
+			entity = std::make_shared<Rock>(pos, tilemap, shader_program);
+		entity->setEnabled(true);
+		entities.push_back(entity);
+	}
+
+	// Full physics steps, like Scene::update does them
+	std::vector<Entity*> moving;
+	std::vector<TileBody> bodies;
+	std::vector<Entity*> impacts;
+	double step_seconds = timeIt([&]()
+		{
+			for (int frame = 0; frame < frames; ++frame)
+			{
+				for (auto& entity : entities)
+					entity->update(DELTA_TIME);
+
+				PhysicsBodies::integrate(DELTA_TIME);
+
+				moving.clear();
+				bodies.clear();
+				for (auto& entity : entities)
+				{
+					if (entity->hasPendingMovement())
+					{
+						moving.push_back(entity.get());
+						bodies.push_back(entity->getTileBody());
+					}
+				}
+
+				tilemap->resolveBodies(bodies);
+
+				for (std::size_t i = 0; i < moving.size(); ++i)
+				{
+					if (bodies[i].x_impact)
+						impacts.push_back(moving[i]);
+					if (bodies[i].y_impact)
+						impacts.push_back(moving[i]);
+					moving[i]->applyTileBody(bodies[i]);
+				}
+			}
+		});
+
+	// The check done on every impact, alone, over the impacts the physics had. Each version counts the throwables
+	// it finds, which are printed so that neither check can be optimized away
+	long long cast_throwables = 0;
+	double cast_seconds = timeIt([&]()
+		{
+			for (Entity* entity : impacts)
+				cast_throwables += dynamic_cast<ThrowableTile*>(entity) != nullptr;
+		});
+	long long tag_throwables = 0;
+	double tag_seconds = timeIt([&]()
+		{
+			for (Entity* entity : impacts)
+				tag_throwables += entity->isThrowable();
+		});
+
+	double entity_frames = static_cast<double>(num_entities) * frames;
+	double num_impacts = static_cast<double>(std::max<std::size_t>(impacts.size(), 1));
+	std::cout << num_entities << " entities, " << frames << " frames, " << impacts.size() << " tile impacts" << std::endl;
+	std::cout << "Physics step: " << step_seconds * 1e9 / entity_frames << " ns per entity and frame" << std::endl;
+	std::cout << "dynamic_cast: " << cast_seconds * 1e9 / num_impacts << " ns per impact, " << cast_throwables << " throwable" << std::endl;
+	std::cout << "Type tag: " << tag_seconds * 1e9 / num_impacts << " ns per impact, " << tag_throwables << " throwable" << std::endl;
+
+	return 0;
+}
@@ -1,6 +1,7 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "Game.h"
+#include "TextureCache.h"
 
 #define TARGET_FRAMERATE 60.0f
 
@@ -86,6 +87,9 @@ int main(void)
 		glfwPollEvents();
 	}
 
+	TextureCache::printStats(std::cout);
+
+	Game::free();
 	glfwTerminate();
 	return 0;
 }
@@ -1,17 +1,21 @@
 #version 330
 
-uniform mat4 projection, modelview;
-uniform vec2 texCoordDispl;
+uniform mat4 projection;
 
-in vec2 position;
-in vec2 texCoord;
+// The corner of the unit quad, from its top left (0,0) to its bottom right (1,1)
+in vec2 corner;
+
+// One per instance: the position of the top left corner of the quad and its size, in pixels, and the texture
+// coordinates of its top left and bottom right corners
+in vec4 quadRect;
+in vec4 texRect;
 out vec2 texCoordFrag;
 
 void main()
 {
-	// Pass texture coordinates to access a given texture atlas
-	texCoordFrag = texCoord + texCoordDispl;
+	// A texture rectangle with its x coordinates swapped flips the quad horizontally
+	texCoordFrag = mix(texRect.xy, texRect.zw, corner);
 	// Transform position from pixel coordinates to clipping coordinates
-	gl_Position = projection * modelview * vec4(position, 0.0, 1.0);
+	gl_Position = projection * vec4(quadRect.xy + corner * quadRect.zw, 0.0, 1.0);
 }
 
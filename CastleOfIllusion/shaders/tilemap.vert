@@ -0,0 +1,32 @@
+#version 330
+
+uniform mat4 projection;
+
+// The top left corner of the map, and the distance between tiles and the size they are drawn at, in pixels
+uniform vec2 mapOrigin;
+uniform vec2 tileSize;
+
+// Where the tilesheet is in the bound texture, the size of one of its tiles and of half a texel
+uniform vec2 tilesheetOrigin;
+uniform vec2 tileTexSize;
+uniform vec2 halfTexel;
+
+// One per instance: the position of the tile in the map and in the tilesheet, in tiles
+in uvec4 tile;
+out vec2 texCoordFrag;
+
+// The two triangles of the quad, from its top left corner (0,0) to its bottom right one (1,1)
+const vec2 corners[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+								vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main()
+{
+	vec2 corner = corners[gl_VertexID];
+
+	// Stop half a texel before the right and bottom sides, so that the next tile in the tilesheet never shows
+	texCoordFrag = tilesheetOrigin + vec2(tile.zw) * tileTexSize + corner * (tileTexSize - halfTexel);
+
+	vec2 position = mapOrigin + vec2(tile.xy) * tileSize.x + corner * tileSize.y;
+	gl_Position = projection * vec4(position, 0.0, 1.0);
+}
+